@@ -72,16 +72,40 @@
 #include <string.h>
 #include <stdio.h>
 #include <ctype.h>
+#include <sys/stat.h>
 #include <limits>
 #include <sstream>
+#include <fstream>
+#include <map>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
 
 #include "hashmgr.hxx"
 #include "csutil.hxx"
 #include "atypes.hxx"
 
+// identity of the files a cached word list was built from
+struct cache_source {
+  unsigned long long size;
+  long long mtime;
+  unsigned long long hash;
+};
+
+struct HashMgr::cache_key {
+  cache_source aff;
+  cache_source dic;
+  int tablesize;
+};
+
 // build a hash table from a munched word list
 
-HashMgr::HashMgr(const char* tpath, const char* apath, const char* key)
+HashMgr::HashMgr(const char* tpath, const char* apath, const char* key,
+                 const char* cachepath)
     : tablesize(0),
       tableptr(NULL),
       flag_mode(FLAG_CHAR),
@@ -97,7 +121,15 @@ HashMgr::HashMgr(const char* tpath, const char* apath, const char* key)
   langnum = 0;
   csconv = 0;
   load_config(apath, key);
-  int ec = load_tables(tpath, key);
+  int ec = 0;
+  cache_key ck;
+  // encrypted dictionaries are never cached
+  bool cacheable = cachepath && !key && read_cache_key(tpath, apath, ck);
+  if (!cacheable || !load_cache(cachepath, ck)) {
+    ec = load_tables(tpath, key);
+    if (!ec && cacheable)
+      save_cache(cachepath, ck);
+  }
   if (ec) {
     /* error condition - what should we do here */
     HUNSPELL_WARNING(stderr, "Hash Manager Error : %d\n", ec);
@@ -112,24 +144,7 @@ HashMgr::HashMgr(const char* tpath, const char* apath, const char* key)
 }
 
 HashMgr::~HashMgr() {
-  if (tableptr) {
-    // now pass through hash table freeing up everything
-    // go through column by column of the table
-    for (int i = 0; i < tablesize; i++) {
-      struct hentry* pt = tableptr[i];
-      struct hentry* nt = NULL;
-      while (pt) {
-        nt = pt->next;
-        if (pt->astr &&
-            (!aliasf || TESTAFF(pt->astr, ONLYUPCASEFLAG, pt->alen)))
-          free(pt->astr);
-        free(pt);
-        pt = nt;
-      }
-    }
-    free(tableptr);
-  }
-  tablesize = 0;
+  free_table();
 
   if (aliasf) {
     for (int j = 0; j < (numaliasf); j++)
@@ -160,6 +175,28 @@ HashMgr::~HashMgr() {
 #endif
 }
 
+void HashMgr::free_table() {
+  if (tableptr) {
+    // now pass through hash table freeing up everything
+    // go through column by column of the table
+    for (int i = 0; i < tablesize; i++) {
+      struct hentry* pt = tableptr[i];
+      struct hentry* nt = NULL;
+      while (pt) {
+        nt = pt->next;
+        if (pt->astr &&
+            (!aliasf || TESTAFF(pt->astr, ONLYUPCASEFLAG, pt->alen)))
+          free(pt->astr);
+        free(pt);
+        pt = nt;
+      }
+    }
+    free(tableptr);
+    tableptr = NULL;
+  }
+  tablesize = 0;
+}
+
 // lookup a root word in the hashtable
 
 struct hentry* HashMgr::lookup(const char* word) const {
@@ -481,6 +518,29 @@ struct hentry* HashMgr::walk_hashtable(int& col, struct hentry* hp) const {
   return NULL;
 }
 
+// hash table size for the first line of a dic file, 0 if its word count is bad
+static int dic_table_size(std::string ts) {
+  mychomp(ts);
+
+  /* remove byte order mark */
+  if (ts.compare(0, 3, "\xEF\xBB\xBF", 3) == 0) {
+    ts.erase(0, 3);
+  }
+
+  int size = atoi(ts.c_str());
+
+  int nExtra = 5 + USERWORD;
+
+  if (size <= 0 ||
+      (size >= (std::numeric_limits<int>::max() - 1 - nExtra) /
+                   int(sizeof(struct hentry*))))
+    return 0;
+  size += nExtra;
+  if ((size % 2) == 0)
+    size++;
+  return size;
+}
+
 // load a munched word list and build a hash table on the fly
 int HashMgr::load_tables(const char* tpath, const char* key) {
   // open dictionary file
@@ -495,28 +555,13 @@ int HashMgr::load_tables(const char* tpath, const char* key) {
     delete dict;
     return 2;
   }
-  mychomp(ts);
-
-  /* remove byte order mark */
-  if (ts.compare(0, 3, "\xEF\xBB\xBF", 3) == 0) {
-    ts.erase(0, 3);
-  }
-
-  tablesize = atoi(ts.c_str());
-
-  int nExtra = 5 + USERWORD;
-
-  if (tablesize <= 0 ||
-      (tablesize >= (std::numeric_limits<int>::max() - 1 - nExtra) /
-                        int(sizeof(struct hentry*)))) {
+  tablesize = dic_table_size(ts);
+  if (!tablesize) {
     HUNSPELL_WARNING(
         stderr, "error: line 1: missing or bad word count in the dic file\n");
     delete dict;
     return 4;
   }
-  tablesize += nExtra;
-  if ((tablesize % 2) == 0)
-    tablesize++;
 
   // allocate the hash table
   tableptr = (struct hentry**)calloc(tablesize, sizeof(struct hentry*));
@@ -616,6 +661,410 @@ int HashMgr::load_tables(const char* tpath, const char* key) {
   return 0;
 }
 
+// Binary cache of the parsed word list. The tables are stored bucket by
+// bucket in chain order, so loading only rebuilds the entries without
+// parsing lines, decoding flags or adding hidden capitalized forms.
+// Entries are still allocated one by one, as the rest of HashMgr frees
+// and replaces them individually.
+
+#define CACHE_MAGIC "HUNSPELLCACHE"
+#define CACHE_VERSION 1
+
+// entry flag vector storage
+#define CACHE_ASTR_NONE 0
+#define CACHE_ASTR_INLINE 1
+#define CACHE_ASTR_ALIAS 2
+
+namespace {
+
+struct cache_header {
+  char magic[sizeof(CACHE_MAGIC)];
+  unsigned int version;
+  unsigned int entry_size;  // guards against a different hentry layout
+  struct cache_source aff;
+  struct cache_source dic;
+  int tablesize;
+  int bucket_count;
+  unsigned long long payload_size;
+};
+
+bool read_cache_source(const char* path, cache_source& source) {
+  struct stat st;
+  if (stat(path, &st) != 0)
+    return false;
+  std::ifstream f;
+  myopen(f, path, std::ios_base::in | std::ios_base::binary);
+  if (!f.is_open())
+    return false;
+  // FNV-1a
+  unsigned long long hash = 14695981039346656037ULL;
+  unsigned long long size = 0;
+  char buf[64 * 1024];
+  while (f) {
+    f.read(buf, sizeof(buf));
+    std::streamsize n = f.gcount();
+    for (std::streamsize i = 0; i < n; ++i) {
+      hash ^= (unsigned char)buf[i];
+      hash *= 1099511628211ULL;
+    }
+    size += n;
+  }
+  if (f.bad())
+    return false;
+  source.size = size;
+  source.mtime = (long long)st.st_mtime;
+  source.hash = hash;
+  return true;
+}
+
+bool same_source(const cache_source& a, const cache_source& b) {
+  return a.size == b.size && a.mtime == b.mtime && a.hash == b.hash;
+}
+
+// read-only view of a whole file, memory-mapped where available
+class cache_view {
+ public:
+  explicit cache_view(const char* path)
+      : view(NULL), length(0) {
+#ifdef _WIN32
+    mapping = NULL;
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                       OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+      return;
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0 ||
+        (unsigned long long)file_size.QuadPart > (size_t)-1)
+      return;
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping)
+      return;
+    view = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view)
+      length = (size_t)file_size.QuadPart;
+#else
+    std::ifstream f;
+    myopen(f, path, std::ios_base::in | std::ios_base::binary);
+    if (!f.is_open())
+      return;
+    buffer.assign(std::istreambuf_iterator<char>(f),
+                  std::istreambuf_iterator<char>());
+    if (!buffer.empty()) {
+      view = &buffer[0];
+      length = buffer.size();
+    }
+#endif
+  }
+
+  ~cache_view() {
+#ifdef _WIN32
+    if (view)
+      UnmapViewOfFile(view);
+    if (mapping)
+      CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE)
+      CloseHandle(file);
+#endif
+  }
+
+  const char* data() const { return view; }
+  size_t size() const { return length; }
+
+ private:
+  cache_view(const cache_view&);
+  cache_view& operator=(const cache_view&);
+
+#ifdef _WIN32
+  HANDLE file;
+  HANDLE mapping;
+#else
+  std::vector<char> buffer;
+#endif
+  const char* view;
+  size_t length;
+};
+
+// bounds checked reader over the cache payload
+class cache_reader {
+ public:
+  cache_reader(const char* begin, const char* end) : pos(begin), end(end) {}
+
+  template <typename T>
+  bool read(T& value) {
+    if ((size_t)(end - pos) < sizeof(T))
+      return false;
+    memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+  }
+
+  const char* take(size_t count) {
+    if ((size_t)(end - pos) < count)
+      return NULL;
+    const char* result = pos;
+    pos += count;
+    return result;
+  }
+
+  bool at_end() const { return pos == end; }
+
+ private:
+  const char* pos;
+  const char* end;
+};
+
+template <typename T>
+void write_value(std::string& out, const T& value) {
+  out.append((const char*)&value, sizeof(T));
+}
+
+}  // namespace
+
+bool HashMgr::read_cache_key(const char* tpath,
+                             const char* apath,
+                             cache_key& ck) const {
+  if (!read_cache_source(apath, ck.aff) || !read_cache_source(tpath, ck.dic))
+    return false;
+  FileMgr dict(tpath, NULL);
+  std::string ts;
+  ck.tablesize = dict.getline(ts) ? dic_table_size(ts) : 0;
+  return ck.tablesize != 0;
+}
+
+bool HashMgr::load_cache(const char* cachepath, const cache_key& ck) {
+  cache_view file(cachepath);
+  cache_header header;
+  if (file.size() < sizeof(header))
+    return false;
+  memcpy(&header, file.data(), sizeof(header));
+  if (memcmp(header.magic, CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+      header.version != CACHE_VERSION ||
+      header.entry_size != sizeof(struct hentry) ||
+      !same_source(header.aff, ck.aff) || !same_source(header.dic, ck.dic) ||
+      header.tablesize != ck.tablesize || header.bucket_count < 0 ||
+      header.payload_size != file.size() - sizeof(header))
+    return false;
+
+  tablesize = header.tablesize;
+  tableptr = (struct hentry**)calloc(tablesize, sizeof(struct hentry*));
+  if (!tableptr) {
+    tablesize = 0;
+    return false;
+  }
+
+  cache_reader in(file.data() + sizeof(header), file.data() + file.size());
+  std::vector<struct hentry*> chain;
+  std::vector<unsigned int> homonyms;
+  for (int b = 0; b < header.bucket_count; ++b) {
+    int bucket;
+    unsigned int chain_length;
+    if (!in.read(bucket) || !in.read(chain_length) || bucket < 0 ||
+        bucket >= tablesize || tableptr[bucket] || chain_length == 0) {
+      free_table();
+      return false;
+    }
+    chain.clear();
+    homonyms.clear();
+    struct hentry** tail = &tableptr[bucket];
+    for (unsigned int e = 0; e < chain_length; ++e) {
+      unsigned char blen, clen, var, astr_kind;
+      short alen;
+      unsigned int homonym;
+      const char* word = NULL;
+      if (!in.read(blen) || !in.read(clen) || !in.read(var) ||
+          !in.read(astr_kind) || !in.read(alen) || !in.read(homonym) ||
+          (homonym != 0 && homonym >= chain_length - e) ||
+          !(word = in.take(blen))) {
+        free_table();
+        return false;
+      }
+
+      unsigned short* astr = NULL;
+      bool ok = true;
+      if (astr_kind == CACHE_ASTR_INLINE) {
+        const char* flags = alen >= 0 ? in.take(alen * sizeof(unsigned short)) : NULL;
+        if (flags) {
+          // empty flag vectors ("word/") are allocated too
+          astr = (unsigned short*)malloc((alen ? alen : 1) * sizeof(unsigned short));
+          if (astr)
+            memcpy(astr, flags, alen * sizeof(unsigned short));
+        }
+        ok = astr != NULL;
+      } else if (astr_kind == CACHE_ASTR_ALIAS) {
+        int index;
+        ok = aliasf && in.read(index) && index >= 0 && index < numaliasf &&
+             alen == aliasflen[index];
+        if (ok)
+          astr = aliasf[index];
+      } else {
+        ok = astr_kind == CACHE_ASTR_NONE && alen == 0;
+      }
+      // the same ownership rule as in the destructor, otherwise the flags
+      // would be leaked or freed twice
+      if (ok && astr &&
+          (!aliasf || TESTAFF(astr, ONLYUPCASEFLAG, alen)) !=
+              (astr_kind == CACHE_ASTR_INLINE))
+        ok = false;
+      // lookup relies on the word being in the bucket of its hash
+      if (ok) {
+        std::string w(word, blen);
+        ok = w.find('\0') == std::string::npos && hash(w.c_str()) == bucket;
+      }
+
+      std::string desc;
+      char* desc_alias = NULL;
+      if (ok && (var & H_OPT)) {
+        if (var & H_OPT_ALIASM) {
+          int index;
+          ok = aliasm && in.read(index) && index >= -1 && index < numaliasm;
+          if (ok && index >= 0)
+            desc_alias = aliasm[index];
+        } else {
+          unsigned int desc_length;
+          const char* text = NULL;
+          ok = in.read(desc_length) && (text = in.take(desc_length)) != NULL;
+          if (ok)
+            desc.assign(text, desc_length);
+        }
+      }
+
+      int descl = (var & H_OPT) ? ((var & H_OPT_ALIASM) ? sizeof(char*) : desc.size() + 1) : 0;
+      struct hentry* hp =
+          ok ? (struct hentry*)malloc(sizeof(struct hentry) + blen + descl) : NULL;
+      if (!hp) {
+        if (astr && astr_kind == CACHE_ASTR_INLINE)
+          free(astr);
+        free_table();
+        return false;
+      }
+      hp->blen = blen;
+      hp->clen = clen;
+      hp->alen = alen;
+      hp->astr = astr;
+      hp->next = NULL;
+      hp->next_homonym = NULL;
+      hp->var = (char)var;
+      memcpy(hp->word, word, blen);
+      hp->word[blen] = '\0';
+      if (var & H_OPT) {
+        if (var & H_OPT_ALIASM)
+          store_pointer(hp->word + blen + 1, desc_alias);
+        else
+          memcpy(hp->word + blen + 1, desc.c_str(), desc.size() + 1);
+      }
+      *tail = hp;
+      tail = &hp->next;
+      chain.push_back(hp);
+      homonyms.push_back(homonym);
+    }
+    for (size_t e = 0; e < chain.size(); ++e)
+      if (homonyms[e])
+        chain[e]->next_homonym = chain[e + homonyms[e]];
+  }
+  if (!in.at_end()) {
+    free_table();
+    return false;
+  }
+  return true;
+}
+
+bool HashMgr::save_cache(const char* cachepath, const cache_key& ck) const {
+  std::map<const unsigned short*, int> flag_aliases;
+  for (int i = 0; i < numaliasf; ++i)
+    flag_aliases[aliasf[i]] = i;
+  std::map<const char*, int> morph_aliases;
+  for (int i = 0; i < numaliasm; ++i)
+    morph_aliases[aliasm[i]] = i;
+
+  std::string payload;
+  int bucket_count = 0;
+  std::vector<struct hentry*> chain;
+  for (int i = 0; i < tablesize; ++i) {
+    if (!tableptr[i])
+      continue;
+    chain.clear();
+    for (struct hentry* hp = tableptr[i]; hp; hp = hp->next)
+      chain.push_back(hp);
+    write_value(payload, i);
+    write_value(payload, (unsigned int)chain.size());
+    for (size_t e = 0; e < chain.size(); ++e) {
+      struct hentry* hp = chain[e];
+      unsigned int homonym = 0;
+      if (hp->next_homonym) {
+        for (size_t h = e + 1; h < chain.size() && !homonym; ++h)
+          if (chain[h] == hp->next_homonym)
+            homonym = (unsigned int)(h - e);
+        if (!homonym)
+          return false;
+      }
+      // the same ownership rule as in the destructor
+      bool owned_astr =
+          hp->astr && (!aliasf || TESTAFF(hp->astr, ONLYUPCASEFLAG, hp->alen));
+      unsigned char astr_kind = !hp->astr ? CACHE_ASTR_NONE
+                                : owned_astr ? CACHE_ASTR_INLINE
+                                             : CACHE_ASTR_ALIAS;
+      write_value(payload, hp->blen);
+      write_value(payload, hp->clen);
+      write_value(payload, (unsigned char)hp->var);
+      write_value(payload, astr_kind);
+      write_value(payload, hp->alen);
+      write_value(payload, homonym);
+      payload.append(hp->word, hp->blen);
+      if (astr_kind == CACHE_ASTR_INLINE) {
+        if (hp->alen < 0)
+          return false;
+        payload.append((const char*)hp->astr, hp->alen * sizeof(unsigned short));
+      } else if (astr_kind == CACHE_ASTR_ALIAS) {
+        std::map<const unsigned short*, int>::const_iterator it = flag_aliases.find(hp->astr);
+        if (it == flag_aliases.end())
+          return false;
+        write_value(payload, it->second);
+      }
+      if (hp->var & H_OPT) {
+        if (hp->var & H_OPT_ALIASM) {
+          const char* desc = get_stored_pointer(hp->word + hp->blen + 1);
+          int index = -1;
+          if (desc) {
+            std::map<const char*, int>::const_iterator it = morph_aliases.find(desc);
+            if (it == morph_aliases.end())
+              return false;
+            index = it->second;
+          }
+          write_value(payload, index);
+        } else {
+          const char* desc = hp->word + hp->blen + 1;
+          unsigned int desc_length = (unsigned int)strlen(desc);
+          write_value(payload, desc_length);
+          payload.append(desc, desc_length);
+        }
+      }
+    }
+    ++bucket_count;
+  }
+
+  cache_header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+  header.version = CACHE_VERSION;
+  header.entry_size = sizeof(struct hentry);
+  header.aff = ck.aff;
+  header.dic = ck.dic;
+  header.tablesize = tablesize;
+  header.bucket_count = bucket_count;
+  header.payload_size = payload.size();
+
+  // failing to write the cache (e.g. read-only directory) is not an error
+  FILE* f = fopen(cachepath, "wb");
+  if (!f)
+    return false;
+  bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+            (payload.empty() || fwrite(payload.data(), payload.size(), 1, f) == 1);
+  ok = fclose(f) == 0 && ok;
+  if (!ok)
+    ::remove(cachepath);
+  return ok;
+}
+
 // the hash function is a simple load and rotate
 // algorithm borrowed
 int HashMgr::hash(const char* word) const {
@@ -101,7 +101,8 @@ class HashMgr {
   char** aliasm;
 
  public:
-  HashMgr(const char* tpath, const char* apath, const char* key = NULL);
+  HashMgr(const char* tpath, const char* apath, const char* key = NULL,
+          const char* cachepath = NULL);
   ~HashMgr();
 
   struct hentry* lookup(const char*) const;
@@ -121,6 +122,7 @@ class HashMgr {
   char* get_aliasm(int index) const;
 
  private:
+  struct cache_key;
   int get_clen_and_captype(const std::string& word, int* captype);
   int get_clen_and_captype(const std::string& word, int* captype, std::vector<w_char> &workbuf);
   int load_tables(const char* tpath, const char* key);
@@ -140,6 +142,10 @@ class HashMgr {
                                   int captype);
   bool parse_aliasm(const std::string& line, FileMgr* af);
   int remove_forbidden_flag(const std::string& word);
+  void free_table();
+  bool read_cache_key(const char* tpath, const char* apath, cache_key& ck) const;
+  bool load_cache(const char* cachepath, const cache_key& ck);
+  bool save_cache(const char* cachepath, const cache_key& ck) const;
 };
 
 #endif
@@ -86,7 +86,7 @@
 class HunspellImpl
 {
 public:
-  HunspellImpl(const char* affpath, const char* dpath, const char* key);
+  HunspellImpl(const char* affpath, const char* dpath, const char* key, const char* cachepath);
   ~HunspellImpl();
   int add_dic(const char* dpath, const char* key);
   std::vector<std::string> suffix_suggest(const std::string& root_word);
@@ -105,6 +105,7 @@ public:
   int add(const std::string& word);
   int add_with_affix(const std::string& word, const std::string& example);
   int remove(const std::string& word);
+  std::vector<std::string> get_words() const;
   const std::string& get_version() const;
   struct cs_info* get_csconv();
   std::vector<char> dic_encoding_vec;
@@ -150,18 +151,18 @@ private:
   HunspellImpl& operator=(const HunspellImpl&);
 };
 
-Hunspell::Hunspell(const char* affpath, const char* dpath, const char* key)
-  : m_Impl(new HunspellImpl(affpath, dpath, key)) {
+Hunspell::Hunspell(const char* affpath, const char* dpath, const char* key, const char* cachepath)
+  : m_Impl(new HunspellImpl(affpath, dpath, key, cachepath)) {
 }
 
-HunspellImpl::HunspellImpl(const char* affpath, const char* dpath, const char* key) {
+HunspellImpl::HunspellImpl(const char* affpath, const char* dpath, const char* key, const char* cachepath) {
   csconv = NULL;
   utf8 = 0;
   complexprefixes = 0;
   affixpath = mystrdup(affpath);
 
   /* first set up the hash manager */
-  m_HMgrs.push_back(new HashMgr(dpath, affpath, key));
+  m_HMgrs.push_back(new HashMgr(dpath, affpath, key, cachepath));
 
   /* next set up the affix manager */
   /* it needs access to the hash manager lookup methods */
@@ -1837,6 +1838,21 @@ namespace {
   }
 }
 
+std::vector<std::string> Hunspell::get_words() const {
+  return m_Impl->get_words();
+}
+
+std::vector<std::string> HunspellImpl::get_words() const {
+  std::vector<std::string> words;
+  for (size_t i = 0; i < m_HMgrs.size(); ++i) {
+    int col = -1;
+    for (struct hentry* hp = m_HMgrs[i]->walk_hashtable(col, NULL); hp;
+         hp = m_HMgrs[i]->walk_hashtable(col, hp))
+      words.push_back(std::string(hp->word, hp->blen));
+  }
+  return words;
+}
+
 void Hunspell::free_list(char*** slst, int n) {
   Hunspell_free_list((Hunhandle*)(this), slst, n);
 }
@@ -111,8 +111,12 @@ class LIBHUNSPELL_DLL_EXPORTED Hunspell {
    * prefix \\\\?\\ to handle system-independent character encoding and very
    * long path names (without the long path prefix Hunspell will use fopen()
    * with system-dependent character encoding instead of _wfopen()).
+   *
+   * cachepath (optional): file for the binary cache of the parsed dictionary
+   * word list, reused while the affix and dictionary files stay unchanged.
    */
-  Hunspell(const char* affpath, const char* dpath, const char* key = NULL);
+  Hunspell(const char* affpath, const char* dpath, const char* key = NULL,
+           const char* cachepath = NULL);
   ~Hunspell();
 
   /* load extra dictionaries (only dic files) */
@@ -209,6 +213,9 @@ class LIBHUNSPELL_DLL_EXPORTED Hunspell {
 
   /* other */
 
+  /* words of all loaded dictionaries as they are stored, without affixes */
+  std::vector<std::string> get_words() const;
+
   /* get extra word characters definied in affix file for tokenization */
   const char* get_wordchars() const;
   const std::string& get_wordchars_cpp() const;
@@ -0,0 +1,68 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Set of 64-bit hashes which may report false positives but never false negatives
+class BloomFilter {
+public:
+  BloomFilter() = default;
+  BloomFilter(size_t expected_count, double false_positive_rate) {
+    const auto count = static_cast<double>(std::max<size_t>(expected_count, 1));
+    const auto ln2 = std::log(2.0);
+    const auto bit_count = std::max(std::ceil(-count * std::log(false_positive_rate) / (ln2 * ln2)), 64.0);
+    m_words.resize(static_cast<size_t>(bit_count) / 64 + 1);
+    m_hash_count = std::clamp(static_cast<int>(std::round(bit_count / count * ln2)), 1, 16);
+  }
+
+  void insert(uint64_t hash) {
+    for_each_bit(hash, [this](size_t bit) { m_words[bit / 64] |= uint64_t{1} << (bit % 64); });
+    ++m_count;
+  }
+
+  bool may_contain(uint64_t hash) const {
+    bool result = true;
+    for_each_bit(hash, [&](size_t bit) { result = result && (m_words[bit / 64] & (uint64_t{1} << (bit % 64))) != 0; });
+    return result;
+  }
+
+  size_t memory_usage() const { return m_words.size() * sizeof(uint64_t); }
+  size_t size() const { return m_count; }
+  // Expected false positive rate for current number of inserted hashes
+  double false_positive_rate() const {
+    if (m_words.empty())
+      return 1.0;
+    const auto bit_count = static_cast<double>(m_words.size() * 64);
+    return std::pow(1.0 - std::exp(-m_hash_count * static_cast<double>(m_count) / bit_count), m_hash_count);
+  }
+
+private:
+  template <typename FunctionType> void for_each_bit(uint64_t hash, const FunctionType &fn) const {
+    // double hashing, second hash is derived from the first one and made odd
+    const auto bit_count = m_words.size() * 64;
+    const auto step = ((hash >> 32) | (hash << 32)) * 0x9E3779B97F4A7C15ull | 1;
+    for (int i = 0; i < m_hash_count; ++i, hash += step)
+      fn(static_cast<size_t>(hash % bit_count));
+  }
+
+private:
+  std::vector<uint64_t> m_words;
+  int m_hash_count = 0;
+  size_t m_count = 0;
+};
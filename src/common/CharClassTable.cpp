@@ -0,0 +1,85 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "CharClassTable.h"
+
+#include "DelimiterSet.h"
+#include "Utility.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+constexpr size_t char_count = size_t{std::numeric_limits<uint16_t>::max()} + 1;
+} // namespace
+
+CharClassTable::CharClassTable() : CharClassTable(system()) {
+}
+
+CharClassTable::CharClassTable(FromSystemTag) : m_classes(char_count) {
+  for (size_t i = 0; i < char_count; ++i) {
+    const auto c = static_cast<wchar_t>(i);
+    uint8_t classes = 0;
+    if (IsCharUpper(c))
+      classes |= upper;
+    if (IsCharLower(c))
+      classes |= lower;
+    if (IsCharAlpha(c))
+      classes |= alpha;
+    else if (IsCharAlphaNumeric(c))
+      classes |= digit;
+    m_classes[i] = classes;
+  }
+}
+
+const CharClassTable &CharClassTable::system() {
+  static const CharClassTable table{FromSystemTag{}};
+  return table;
+}
+
+template <typename IsDelimiterType> void CharClassTable::set_delimiters_by(const IsDelimiterType &is_delimiter) {
+  for (size_t i = 0; i < char_count; ++i) {
+    if (is_delimiter(static_cast<wchar_t>(i)))
+      m_classes[i] |= delimiter;
+    else
+      m_classes[i] &= static_cast<uint8_t>(~delimiter);
+  }
+}
+
+void CharClassTable::set_delimiters(const DelimiterSet &delimiters) {
+  set_delimiters_by(delimiters);
+}
+
+void CharClassTable::set_non_alphabetic_delimiters(std::wstring_view exclusions) {
+  set_delimiters_by([&](wchar_t c) { return !has(c, alpha | digit) && exclusions.find(c) == std::wstring_view::npos; });
+}
+
+void CharClassTable::set_non_ansi_delimiters(std::wstring_view exclusions) {
+  std::string ansi_chars;
+  for (int i = 1; i <= std::numeric_limits<unsigned char>::max(); ++i)
+    ansi_chars.push_back(static_cast<char>(i));
+  auto ansi_alphanumeric = to_wstring(ansi_chars);
+  std::erase_if(ansi_alphanumeric, [this](wchar_t c) { return !has(c, alpha | digit); });
+  std::sort(ansi_alphanumeric.begin(), ansi_alphanumeric.end());
+  set_delimiters_by([&](wchar_t c) {
+    return !std::binary_search(ansi_alphanumeric.begin(), ansi_alphanumeric.end(), c) && exclusions.find(c) == std::wstring_view::npos;
+  });
+}
+
+uint32_t CharClassTable::classify_block(const wchar_t *block) const {
+  uint32_t result = 0;
+  for (size_t i = 0; i < block_size; ++i)
+    result |= static_cast<uint32_t>(m_classes[static_cast<uint16_t>(block[i])] & delimiter) << i;
+  return result;
+}
@@ -0,0 +1,62 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+class DelimiterSet;
+
+// Classes of all UTF-16 code units computed once, so that tokenizers don't call winapi per character
+class CharClassTable {
+public:
+  static constexpr size_t block_size = 32;
+
+  // character properties without any delimiters
+  CharClassTable();
+  void set_delimiters(const DelimiterSet &delimiters);
+  // delimiters are all non-alphanumeric characters except `exclusions`
+  void set_non_alphabetic_delimiters(std::wstring_view exclusions);
+  // same but also non-ANSI alphanumeric characters are delimiters
+  void set_non_ansi_delimiters(std::wstring_view exclusions);
+
+  bool operator()(wchar_t c) const { return has(c, delimiter); }
+  bool is_upper(wchar_t c) const { return has(c, upper); }
+  bool is_lower(wchar_t c) const { return has(c, lower); }
+  bool is_digit(wchar_t c) const { return has(c, digit); }
+  bool is_alpha(wchar_t c) const { return has(c, alpha); }
+  // bit i of result is set if block[i] is a delimiter, block should have `block_size` characters
+  uint32_t classify_block(const wchar_t *block) const;
+
+  static const CharClassTable &system();
+
+private:
+  enum : uint8_t {
+    delimiter = 1 << 0,
+    upper = 1 << 1,
+    lower = 1 << 2,
+    digit = 1 << 3,
+    alpha = 1 << 4,
+  };
+
+  struct FromSystemTag {};
+  explicit CharClassTable(FromSystemTag);
+  bool has(wchar_t c, uint8_t flag) const { return (m_classes[static_cast<uint16_t>(c)] & flag) != 0; }
+  template <typename IsDelimiterType> void set_delimiters_by(const IsDelimiterType &is_delimiter);
+
+private:
+  std::vector<uint8_t> m_classes;
+};
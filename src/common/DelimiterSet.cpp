@@ -0,0 +1,113 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "DelimiterSet.h"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#include <intrin.h>
+#define DSPELLCHECK_X86
+#endif
+
+#if defined(__clang__)
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#else
+#define AVX2_FUNCTION
+#endif
+
+namespace {
+bool is_avx2_supported() {
+#ifdef DSPELLCHECK_X86
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return false;
+  __cpuid(info, 1);
+  const bool has_osxsave = (info[2] & (1 << 27)) != 0;
+  const bool has_avx = (info[2] & (1 << 28)) != 0;
+  // YMM registers should be saved by OS as well
+  if (!has_osxsave || !has_avx || (_xgetbv(0) & 6) != 6)
+    return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  return false;
+#endif
+}
+} // namespace
+
+DelimiterSet::DelimiterSet(std::wstring_view delimiters) {
+  for (auto c : delimiters) {
+    if (c < 128) {
+      m_ascii[c >> 6] |= uint64_t{1} << (c & 63);
+      m_ascii_nibble_table[c & 15] |= static_cast<uint8_t>(1 << (c >> 4));
+    } else
+      m_non_ascii.push_back(c);
+  }
+  std::sort(m_non_ascii.begin(), m_non_ascii.end());
+  m_non_ascii.erase(std::unique(m_non_ascii.begin(), m_non_ascii.end()), m_non_ascii.end());
+}
+
+bool DelimiterSet::is_non_ascii_delimiter(wchar_t c) const {
+  return std::binary_search(m_non_ascii.begin(), m_non_ascii.end(), c);
+}
+
+uint32_t DelimiterSet::classify_block(const wchar_t *block) const {
+  static const bool use_avx2 = is_avx2_supported();
+  return use_avx2 ? classify_block_avx2(block) : classify_block_scalar(block);
+}
+
+uint32_t DelimiterSet::classify_block_scalar(const wchar_t *block) const {
+  uint32_t result = 0;
+  for (size_t i = 0; i < block_size; ++i)
+    result |= static_cast<uint32_t>((*this)(block[i])) << i;
+  return result;
+}
+
+#ifdef DSPELLCHECK_X86
+AVX2_FUNCTION uint32_t DelimiterSet::classify_block_avx2(const wchar_t *block) const {
+  static_assert(sizeof(wchar_t) == 2 && block_size == 32);
+  const auto byte_max = _mm256_set1_epi16(0xFF);
+  // clamping to 0xFF keeps non-ASCII characters non-ASCII after packing to bytes
+  const auto first = _mm256_min_epu16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(block)), byte_max);
+  const auto second = _mm256_min_epu16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 16)), byte_max);
+  // packing works per 128-bit lane so order of quadwords has to be restored
+  const auto bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(first, second), 0xD8);
+
+  const auto low_nibbles = _mm256_and_si256(bytes, _mm256_set1_epi8(0x0F));
+  const auto high_nibbles = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), _mm256_set1_epi8(0x0F));
+  const auto table = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(m_ascii_nibble_table.data())));
+  // high nibbles above 7 are not ASCII so they get no bits
+  const auto high_nibble_bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, static_cast<char>(128), 0, 0, 0, 0, 0, 0, 0, 0,
+                                                 1, 2, 4, 8, 16, 32, 64, static_cast<char>(128), 0, 0, 0, 0, 0, 0, 0, 0);
+  const auto matched = _mm256_and_si256(_mm256_shuffle_epi8(table, low_nibbles), _mm256_shuffle_epi8(high_nibble_bits, high_nibbles));
+  auto result = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(matched, _mm256_setzero_si256())));
+
+  auto non_ascii = static_cast<uint32_t>(_mm256_movemask_epi8(bytes));
+  while (non_ascii != 0) {
+    const auto i = std::countr_zero(non_ascii);
+    if (is_non_ascii_delimiter(block[i]))
+      result |= uint32_t{1} << i;
+    non_ascii &= non_ascii - 1;
+  }
+  return result;
+}
+#else
+uint32_t DelimiterSet::classify_block_avx2(const wchar_t *block) const {
+  return classify_block_scalar(block);
+}
+#endif
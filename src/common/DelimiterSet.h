@@ -0,0 +1,46 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Delimiter predicate for Tokenizer which could also classify a whole block of characters at once
+class DelimiterSet {
+public:
+  static constexpr size_t block_size = 32;
+
+  explicit DelimiterSet(std::wstring_view delimiters = {});
+  bool operator()(wchar_t c) const {
+    if (c < 128)
+      return ((m_ascii[c >> 6] >> (c & 63)) & 1) != 0;
+    return is_non_ascii_delimiter(c);
+  }
+  // bit i of result is set if block[i] is a delimiter, block should have `block_size` characters
+  uint32_t classify_block(const wchar_t *block) const;
+  uint32_t classify_block_scalar(const wchar_t *block) const;
+
+private:
+  bool is_non_ascii_delimiter(wchar_t c) const;
+  uint32_t classify_block_avx2(const wchar_t *block) const;
+
+private:
+  std::array<uint64_t, 2> m_ascii{};
+  // bit `c >> 4` of entry `c & 15` is set if ASCII character `c` is a delimiter
+  alignas(16) std::array<uint8_t, 16> m_ascii_nibble_table{};
+  std::wstring m_non_ascii; // sorted
+};
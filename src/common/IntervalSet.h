@@ -0,0 +1,109 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+// Set of disjoint half-open intervals [begin, end), adjacent or overlapping intervals are coalesced.
+// Supports shifting positions the same way text positions shift on insertion/deletion.
+template <typename PositionType>
+class IntervalSet {
+public:
+  struct Interval {
+    PositionType begin;
+    PositionType end;
+  };
+
+  void add(PositionType begin, PositionType end) {
+    if (begin >= end)
+      return;
+    // first interval which is not strictly to the left of new one
+    auto first = std::lower_bound(m_intervals.begin(), m_intervals.end(), begin,
+                                  [](const Interval &interval, PositionType pos) { return interval.end < pos; });
+    auto last = first;
+    while (last != m_intervals.end() && last->begin <= end) {
+      begin = std::min(begin, last->begin);
+      end = std::max(end, last->end);
+      ++last;
+    }
+    first = m_intervals.erase(first, last);
+    m_intervals.insert(first, {begin, end});
+  }
+
+  void remove(PositionType begin, PositionType end) {
+    if (begin >= end)
+      return;
+    std::vector<Interval> result;
+    result.reserve(m_intervals.size() + 1);
+    for (auto &interval : m_intervals) {
+      if (interval.end <= begin || interval.begin >= end) {
+        result.push_back(interval);
+        continue;
+      }
+      if (interval.begin < begin)
+        result.push_back({interval.begin, begin});
+      if (interval.end > end)
+        result.push_back({end, interval.end});
+    }
+    m_intervals = std::move(result);
+  }
+
+  bool contains(PositionType begin, PositionType end) const {
+    auto it = std::upper_bound(m_intervals.begin(), m_intervals.end(), begin,
+                               [](PositionType pos, const Interval &interval) { return pos < interval.begin; });
+    if (it == m_intervals.begin())
+      return false;
+    --it;
+    return it->begin <= begin && end <= it->end;
+  }
+
+  // `length` positions were inserted at `pos`
+  void on_insert(PositionType pos, PositionType length) {
+    for (auto &interval : m_intervals) {
+      if (interval.begin >= pos)
+        interval.begin += length;
+      if (interval.end > pos)
+        interval.end += length;
+    }
+  }
+
+  // `length` positions were removed starting from `pos`
+  void on_delete(PositionType pos, PositionType length) {
+    auto shift = [&](PositionType &value) {
+      if (value >= pos + length)
+        value -= length;
+      else if (value > pos)
+        value = pos;
+    };
+    for (auto &interval : m_intervals) {
+      shift(interval.begin);
+      shift(interval.end);
+    }
+    std::erase_if(m_intervals, [](const Interval &interval) { return interval.begin >= interval.end; });
+    // neighbours of removed range could touch each other now
+    auto intervals = std::move(m_intervals);
+    m_intervals.clear();
+    for (auto &interval : intervals)
+      add(interval.begin, interval.end);
+  }
+
+  void clear() { m_intervals.clear(); }
+  bool empty() const { return m_intervals.empty(); }
+  const std::vector<Interval> &intervals() const { return m_intervals; }
+
+private:
+  std::vector<Interval> m_intervals; // sorted, disjoint and non-adjacent
+};
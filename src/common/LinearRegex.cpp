@@ -0,0 +1,530 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "LinearRegex.h"
+
+#include <algorithm>
+
+namespace {
+using Traits = std::regex_traits<wchar_t>;
+
+const Traits &traits() {
+  static const Traits instance;
+  return instance;
+}
+
+constexpr int unbounded = -1;
+constexpr int max_repeat_count = 1000;
+constexpr size_t max_state_count = 1 << 14;
+
+enum class NodeType {
+  char_set,
+  concat,
+  alternation,
+  repeat,
+  line_begin,
+  line_end,
+};
+
+struct Node {
+  NodeType type;
+  int set_index = -1;
+  std::vector<int> children;
+  int min = 0;
+  int max = 0;
+};
+
+// Line terminators not matched by "." differ between implementations, so they are asked from std::wregex itself
+const std::vector<wchar_t> &dot_exclusions() {
+  static const auto instance = [] {
+    std::vector<wchar_t> result;
+    const std::wregex dot(L".");
+    for (auto c : {L'\n', L'\r', L'\u2028', L'\u2029'})
+      if (!std::regex_match(std::wstring(1, c), dot))
+        result.push_back(c);
+    return result;
+  }();
+  return instance;
+}
+
+bool is_ascii_digit(wchar_t c) { return c >= L'0' && c <= L'9'; }
+
+bool is_ascii_alnum(wchar_t c) {
+  return is_ascii_digit(c) || (c >= L'a' && c <= L'z') || (c >= L'A' && c <= L'Z');
+}
+} // namespace
+
+bool LinearRegex::CharSet::contains(wchar_t c) const {
+  if (c < 0x80)
+    return ascii[c];
+  return evaluate(c);
+}
+
+bool LinearRegex::CharSet::evaluate(wchar_t c) const {
+  auto &t = traits();
+  auto result = std::any_of(ranges.begin(), ranges.end(), [c](const auto &range) { return c >= range.first && c <= range.second; }) ||
+                std::any_of(classes.begin(), classes.end(), [&](auto cls) { return t.isctype(c, cls); }) ||
+                std::any_of(negated_classes.begin(), negated_classes.end(), [&](auto cls) { return !t.isctype(c, cls); });
+  return result != negated;
+}
+
+class LinearRegex::Parser {
+public:
+  struct Unsupported {};
+
+  explicit Parser(std::wstring_view pattern) : m_pattern(pattern) {}
+
+  LinearRegex parse() {
+    auto root = parse_disjunction();
+    if (!at_end())
+      throw Unsupported{};
+    auto match = add_state({StateType::match});
+    m_result.m_start = emit(root, match);
+    for (auto &set : m_result.m_sets) {
+      for (wchar_t c = 0; c < 0x80; ++c)
+        set.ascii[c] = set.evaluate(c);
+    }
+    return std::move(m_result);
+  }
+
+private:
+  bool at_end() const { return m_pos == m_pattern.size(); }
+  wchar_t peek() const { return m_pattern[m_pos]; }
+  bool peek_is(wchar_t c) const { return !at_end() && peek() == c; }
+
+  void expect(wchar_t c) {
+    if (!peek_is(c))
+      throw Unsupported{};
+    ++m_pos;
+  }
+
+  int add_node(Node node) {
+    m_nodes.push_back(std::move(node));
+    return static_cast<int>(m_nodes.size()) - 1;
+  }
+
+  static CharSet dot_set() {
+    CharSet set;
+    set.negated = true;
+    for (auto c : dot_exclusions())
+      set.ranges.emplace_back(c, c);
+    return set;
+  }
+
+  int add_set_node(CharSet set) {
+    m_result.m_sets.push_back(std::move(set));
+    return add_node({NodeType::char_set, static_cast<int>(m_result.m_sets.size()) - 1});
+  }
+
+  int add_state(State state) {
+    if (m_result.m_states.size() >= max_state_count)
+      throw Unsupported{};
+    m_result.m_states.push_back(state);
+    return static_cast<int>(m_result.m_states.size()) - 1;
+  }
+
+  int parse_disjunction() {
+    std::vector<int> alternatives{parse_alternative()};
+    while (peek_is(L'|')) {
+      ++m_pos;
+      alternatives.push_back(parse_alternative());
+    }
+    if (alternatives.size() == 1)
+      return alternatives.front();
+    return add_node({NodeType::alternation, -1, std::move(alternatives)});
+  }
+
+  int parse_alternative() {
+    std::vector<int> terms;
+    while (!at_end() && peek() != L'|' && peek() != L')')
+      terms.push_back(parse_term());
+    return add_node({NodeType::concat, -1, std::move(terms)});
+  }
+
+  int parse_term() {
+    if (peek() == L'^' || peek() == L'$') {
+      auto type = peek() == L'^' ? NodeType::line_begin : NodeType::line_end;
+      ++m_pos;
+      return add_node({type});
+    }
+    return parse_quantifier(parse_atom());
+  }
+
+  int parse_number() {
+    if (at_end() || !is_ascii_digit(peek()))
+      throw Unsupported{};
+    int value = 0;
+    while (!at_end() && is_ascii_digit(peek())) {
+      value = std::min(value * 10 + (peek() - L'0'), max_repeat_count + 1);
+      ++m_pos;
+    }
+    return value;
+  }
+
+  int parse_quantifier(int atom) {
+    if (at_end())
+      return atom;
+    int min = 0;
+    int max = 0;
+    switch (peek()) {
+    case L'*':
+      min = 0;
+      max = unbounded;
+      break;
+    case L'+':
+      min = 1;
+      max = unbounded;
+      break;
+    case L'?':
+      min = 0;
+      max = 1;
+      break;
+    case L'{': {
+      ++m_pos;
+      min = parse_number();
+      max = min;
+      if (peek_is(L',')) {
+        ++m_pos;
+        max = peek_is(L'}') ? unbounded : parse_number();
+      }
+      if (!peek_is(L'}') || (max != unbounded && max < min))
+        throw Unsupported{};
+      break;
+    }
+    default:
+      return atom;
+    }
+    ++m_pos;
+    // laziness does not affect whether the whole string matches
+    if (peek_is(L'?'))
+      ++m_pos;
+    if (min > max_repeat_count || max > max_repeat_count)
+      throw Unsupported{};
+    Node node{NodeType::repeat, -1, {atom}};
+    node.min = min;
+    node.max = max;
+    return add_node(std::move(node));
+  }
+
+  int parse_atom() {
+    auto c = m_pattern[m_pos++];
+    switch (c) {
+    case L'.':
+      return add_set_node(dot_set());
+    case L'(': {
+      // only non-capturing groups, lookaheads are not supported
+      if (peek_is(L'?')) {
+        ++m_pos;
+        expect(L':');
+      }
+      auto node = parse_disjunction();
+      expect(L')');
+      return node;
+    }
+    case L'[':
+      return add_set_node(parse_bracket_expression());
+    case L'\\':
+      return parse_atom_escape();
+    case L')':
+    case L']':
+    case L'{':
+    case L'}':
+    case L'*':
+    case L'+':
+    case L'?':
+      // either invalid or treated differently by different implementations
+      throw Unsupported{};
+    default:
+      break;
+    }
+    CharSet set;
+    set.ranges.emplace_back(c, c);
+    return add_set_node(std::move(set));
+  }
+
+  int parse_atom_escape() {
+    if (at_end())
+      throw Unsupported{};
+    CharSet set;
+    if (add_class_escape(peek(), set)) {
+      ++m_pos;
+      return add_set_node(std::move(set));
+    }
+    auto c = parse_char_escape();
+    set.ranges.emplace_back(c, c);
+    return add_set_node(std::move(set));
+  }
+
+  // \d \w \s and their negations
+  static bool add_class_escape(wchar_t c, CharSet &set) {
+    wchar_t name;
+    switch (c) {
+    case L'd':
+    case L'D':
+      name = L'd';
+      break;
+    case L'w':
+    case L'W':
+      name = L'w';
+      break;
+    case L's':
+    case L'S':
+      name = L's';
+      break;
+    default:
+      return false;
+    }
+    auto cls = traits().lookup_classname(&name, &name + 1);
+    if (cls == 0)
+      throw Unsupported{};
+    (c == name ? set.classes : set.negated_classes).push_back(cls);
+    return true;
+  }
+
+  wchar_t parse_hex(int digit_count) {
+    wchar_t value = 0;
+    for (int i = 0; i < digit_count; ++i) {
+      if (at_end())
+        throw Unsupported{};
+      auto c = m_pattern[m_pos++];
+      int digit;
+      if (is_ascii_digit(c))
+        digit = c - L'0';
+      else if (c >= L'a' && c <= L'f')
+        digit = c - L'a' + 10;
+      else if (c >= L'A' && c <= L'F')
+        digit = c - L'A' + 10;
+      else
+        throw Unsupported{};
+      value = static_cast<wchar_t>(value * 16 + digit);
+    }
+    return value;
+  }
+
+  // escapes standing for a single character, backslash is already consumed
+  wchar_t parse_char_escape() {
+    auto c = m_pattern[m_pos++];
+    switch (c) {
+    case L't':
+      return L'\t';
+    case L'n':
+      return L'\n';
+    case L'r':
+      return L'\r';
+    case L'v':
+      return L'\v';
+    case L'f':
+      return L'\f';
+    case L'0':
+      if (!at_end() && is_ascii_digit(peek()))
+        throw Unsupported{};
+      return L'\0';
+    case L'x':
+      return parse_hex(2);
+    case L'u':
+      return parse_hex(4);
+    case L'c': {
+      if (at_end())
+        throw Unsupported{};
+      auto letter = m_pattern[m_pos++];
+      if (!is_ascii_alnum(letter) || is_ascii_digit(letter))
+        throw Unsupported{};
+      return static_cast<wchar_t>(letter % 32);
+    }
+    default:
+      break;
+    }
+    // backreferences, word boundaries and the rest of escaped letters
+    if (is_ascii_alnum(c))
+      throw Unsupported{};
+    return c;
+  }
+
+  // opening bracket is already consumed
+  CharSet parse_bracket_expression() {
+    CharSet set;
+    if (peek_is(L'^')) {
+      ++m_pos;
+      set.negated = true;
+    }
+    // empty class and leading ']' are interpreted differently by different implementations
+    if (at_end() || peek() == L']')
+      throw Unsupported{};
+    while (true) {
+      if (at_end())
+        throw Unsupported{};
+      if (peek() == L']') {
+        ++m_pos;
+        break;
+      }
+      auto first = parse_class_atom(set);
+      if (peek_is(L'-') && m_pos + 1 < m_pattern.size() && m_pattern[m_pos + 1] != L']') {
+        ++m_pos;
+        auto last = parse_class_atom(set);
+        if (!first || !last || *last < *first)
+          throw Unsupported{};
+        set.ranges.emplace_back(*first, *last);
+      }
+      else if (first)
+        set.ranges.emplace_back(*first, *first);
+    }
+    return set;
+  }
+
+  // nullopt if atom was a character class and got added to set directly
+  std::optional<wchar_t> parse_class_atom(CharSet &set) {
+    auto c = m_pattern[m_pos++];
+    if (c == L'[') {
+      if (peek_is(L'=') || peek_is(L'.'))
+        throw Unsupported{};
+      if (!peek_is(L':'))
+        return c;
+      auto name_end = m_pattern.find(L":]", m_pos + 1);
+      if (name_end == std::wstring_view::npos)
+        throw Unsupported{};
+      auto name = m_pattern.substr(m_pos + 1, name_end - m_pos - 1);
+      auto cls = traits().lookup_classname(name.data(), name.data() + name.size());
+      if (cls == 0)
+        throw Unsupported{};
+      set.classes.push_back(cls);
+      m_pos = name_end + 2;
+      return std::nullopt;
+    }
+    if (c != L'\\')
+      return c;
+    if (at_end())
+      throw Unsupported{};
+    if (add_class_escape(peek(), set)) {
+      ++m_pos;
+      return std::nullopt;
+    }
+    if (peek() == L'b') {
+      ++m_pos;
+      return L'\b';
+    }
+    return parse_char_escape();
+  }
+
+  // Thompson construction done backwards: returns entry state of fragment which continues to `next`
+  int emit(int node_index, int next) {
+    const auto &node = m_nodes[node_index];
+    switch (node.type) {
+    case NodeType::char_set:
+      return add_state({StateType::char_set, node.set_index, next});
+    case NodeType::concat:
+      for (auto it = node.children.rbegin(); it != node.children.rend(); ++it)
+        next = emit(*it, next);
+      return next;
+    case NodeType::alternation: {
+      auto entry = emit(node.children.back(), next);
+      for (auto it = std::next(node.children.rbegin()); it != node.children.rend(); ++it)
+        entry = add_state({StateType::split, -1, emit(*it, next), entry});
+      return entry;
+    }
+    case NodeType::repeat:
+      return emit_repeat(node, next);
+    case NodeType::line_begin:
+      return add_state({StateType::line_begin, -1, next});
+    case NodeType::line_end:
+      return add_state({StateType::line_end, -1, next});
+    }
+    throw Unsupported{};
+  }
+
+  int emit_repeat(const Node &node, int next) {
+    auto child = node.children.front();
+    auto entry = next;
+    if (node.max == unbounded) {
+      auto loop = add_state({StateType::split});
+      auto body = emit(child, loop);
+      m_result.m_states[loop].out = body;
+      m_result.m_states[loop].out1 = next;
+      entry = node.min > 0 ? body : loop;
+      for (int i = 1; i < node.min; ++i)
+        entry = emit(child, entry);
+      return entry;
+    }
+    for (int i = node.min; i < node.max; ++i)
+      entry = add_state({StateType::split, -1, emit(child, entry), next});
+    for (int i = 0; i < node.min; ++i)
+      entry = emit(child, entry);
+    return entry;
+  }
+
+private:
+  std::wstring_view m_pattern;
+  size_t m_pos = 0;
+  std::vector<Node> m_nodes;
+  LinearRegex m_result;
+};
+
+std::optional<LinearRegex> LinearRegex::compile(std::wstring_view pattern) {
+  try {
+    return Parser(pattern).parse();
+  } catch (const Parser::Unsupported &) {
+    return std::nullopt;
+  }
+}
+
+void LinearRegex::add_closure(int state, size_t pos, size_t length, std::vector<int> &list, std::vector<int> &stack,
+                              std::vector<size_t> &marks) const {
+  stack.push_back(state);
+  while (!stack.empty()) {
+    auto index = stack.back();
+    stack.pop_back();
+    if (marks[index] == pos)
+      continue;
+    marks[index] = pos;
+    auto &s = m_states[index];
+    switch (s.type) {
+    case StateType::split:
+      stack.push_back(s.out1);
+      stack.push_back(s.out);
+      break;
+    case StateType::line_begin:
+      if (pos == 0)
+        stack.push_back(s.out);
+      break;
+    case StateType::line_end:
+      if (pos == length)
+        stack.push_back(s.out);
+      break;
+    case StateType::char_set:
+    case StateType::match:
+      list.push_back(index);
+      break;
+    }
+  }
+}
+
+bool LinearRegex::full_match(std::wstring_view str) const {
+  std::vector<int> current;
+  std::vector<int> next;
+  std::vector<int> stack;
+  std::vector<size_t> marks(m_states.size(), std::wstring_view::npos);
+  add_closure(m_start, 0, str.size(), current, stack, marks);
+  for (size_t pos = 0; pos < str.size(); ++pos) {
+    if (current.empty())
+      return false;
+    next.clear();
+    for (auto index : current) {
+      auto &s = m_states[index];
+      if (s.type == StateType::char_set && m_sets[s.set_index].contains(str[pos]))
+        add_closure(s.out, pos + 1, str.size(), next, stack, marks);
+    }
+    std::swap(current, next);
+  }
+  return std::any_of(current.begin(), current.end(),
+                     [this](int index) { return m_states[index].type == StateType::match; });
+}
@@ -0,0 +1,73 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include <bitset>
+#include <optional>
+#include <regex>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Matcher for a subset of ECMAScript regular expressions which works in time linear to the length of the string
+// (Thompson NFA simulation, no backtracking).
+// Supported: literals and escapes, ".", bracket expressions (including \d\w\s and [:name:] classes), groups,
+// alternation, greedy and lazy quantifiers, "^" and "$".
+// Not supported: backreferences, lookaheads, word boundaries - compile returns nullopt for them.
+// Character classes are evaluated with std::regex_traits so results are the same as with std::wregex.
+class LinearRegex {
+public:
+  // nullopt if pattern is invalid or uses unsupported syntax
+  static std::optional<LinearRegex> compile(std::wstring_view pattern);
+  // same as std::regex_match
+  bool full_match(std::wstring_view str) const;
+
+private:
+  class Parser;
+
+  struct CharSet {
+    bool contains(wchar_t c) const;
+    bool evaluate(wchar_t c) const;
+
+    std::bitset<128> ascii;
+    std::vector<std::pair<wchar_t, wchar_t>> ranges;
+    std::vector<std::regex_traits<wchar_t>::char_class_type> classes;
+    std::vector<std::regex_traits<wchar_t>::char_class_type> negated_classes;
+    bool negated = false;
+  };
+
+  enum class StateType {
+    char_set,
+    split,
+    line_begin,
+    line_end,
+    match,
+  };
+
+  struct State {
+    StateType type;
+    int set_index = -1;
+    int out = -1;
+    int out1 = -1;
+  };
+
+  void add_closure(int state, size_t pos, size_t length, std::vector<int> &list, std::vector<int> &stack,
+                   std::vector<size_t> &marks) const;
+
+private:
+  std::vector<CharSet> m_sets;
+  std::vector<State> m_states;
+  int m_start = 0;
+};
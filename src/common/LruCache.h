@@ -0,0 +1,76 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include <list>
+#include <unordered_map>
+
+// Map of bounded size, least recently used entry is evicted when it's full.
+template <typename KeyType, typename ValueType>
+class LruCache {
+public:
+  explicit LruCache(size_t capacity) : m_capacity(capacity) {}
+  // index stores iterators into entries so copying isn't possible
+  LruCache(const LruCache &) = delete;
+  LruCache &operator=(const LruCache &) = delete;
+  LruCache(LruCache &&) = default;
+  LruCache &operator=(LruCache &&) = default;
+
+  // Returns nullptr if there's no such key, otherwise entry becomes the most recently used one
+  const ValueType *find(const KeyType &key) {
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+      ++m_miss_count;
+      return nullptr;
+    }
+    ++m_hit_count;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return &it->second->second;
+  }
+
+  void insert(KeyType key, ValueType value) {
+    if (m_capacity == 0)
+      return;
+    if (auto it = m_index.find(key); it != m_index.end()) {
+      it->second->second = std::move(value);
+      m_entries.splice(m_entries.begin(), m_entries, it->second);
+      return;
+    }
+    if (m_index.size() >= m_capacity) {
+      // reusing node of evicted entry
+      m_index.erase(m_entries.back().first);
+      m_entries.splice(m_entries.begin(), m_entries, std::prev(m_entries.end()));
+      m_entries.front() = {std::move(key), std::move(value)};
+    } else
+      m_entries.emplace_front(std::move(key), std::move(value));
+    m_index.emplace(m_entries.front().first, m_entries.begin());
+  }
+
+  void clear() {
+    m_entries.clear();
+    m_index.clear();
+  }
+
+  size_t size() const { return m_index.size(); }
+  size_t hit_count() const { return m_hit_count; }
+  size_t miss_count() const { return m_miss_count; }
+
+private:
+  size_t m_capacity;
+  std::list<std::pair<KeyType, ValueType>> m_entries; // most recently used first
+  std::unordered_map<KeyType, typename std::list<std::pair<KeyType, ValueType>>::iterator> m_index;
+  size_t m_hit_count = 0;
+  size_t m_miss_count = 0;
+};
@@ -14,13 +14,17 @@
 
 #pragma once
 
+#include "SparseMapping.h"
+
 template <typename IndexType>
 class MappedWstringGeneric {
 public:
+  using Mapping = SparseMapping<IndexType>;
+
   IndexType to_original_index(IndexType cur_index) const { return !mapping.empty() ? mapping[cur_index] : cur_index; }
 
   IndexType from_original_index(IndexType cur_index) const {
-    return !mapping.empty() ? static_cast<IndexType>(std::lower_bound(mapping.begin(), mapping.end(), cur_index) - mapping.begin()) : cur_index;
+    return !mapping.empty() ? mapping.lower_bound(cur_index) : cur_index;
   }
 
   IndexType original_length() const { return !mapping.empty() ? mapping.back() : static_cast<IndexType>(str.size()); }
@@ -29,11 +33,11 @@ public:
     if (!str.empty() && !other.str.empty())
       str.push_back(L'\n');
     str.insert(str.end(), other.str.begin(), other.str.end());
-    mapping.insert(mapping.end(), other.mapping.begin(), other.mapping.end());
+    mapping.append(other.mapping);
   }
 
 public:
   std::wstring str;
-  std::vector<IndexType> mapping; // should have size str.length () or empty (if empty mapping is identity a<->a)
+  Mapping mapping; // should have size str.length () or empty (if empty mapping is identity a<->a)
   // indices should correspond to offsets string `str` had in original encoding
 };
@@ -0,0 +1,170 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+// Non-decreasing sequence of indices stored as checkpoints, values between two consecutive checkpoints change linearly.
+// Mostly single-byte text needs only a few checkpoints instead of a value per character.
+template <typename IndexType> class SparseMapping {
+public:
+  SparseMapping() = default;
+  SparseMapping(std::initializer_list<IndexType> values) {
+    for (auto value : values)
+      push_back(value);
+  }
+
+  IndexType size() const { return !m_checkpoints.empty() ? m_checkpoints.back().index + 1 : 0; }
+  bool empty() const { return m_checkpoints.empty(); }
+  IndexType front() const { return m_checkpoints.front().value; }
+  IndexType back() const { return m_checkpoints.back().value; }
+
+  IndexType operator[](IndexType index) const {
+    const auto segment = find_segment(index);
+    const auto &checkpoint = m_checkpoints[segment];
+    if (checkpoint.index == index)
+      return checkpoint.value;
+    return checkpoint.value + (index - checkpoint.index) * step(segment);
+  }
+
+  // First index with value not less than `value`, size() if there is none
+  IndexType lower_bound(IndexType value) const {
+    const auto it = std::partition_point(m_checkpoints.begin(), m_checkpoints.end(), [value](const Checkpoint &checkpoint) { return checkpoint.value < value; });
+    if (it == m_checkpoints.end())
+      return size();
+    if (it == m_checkpoints.begin())
+      return 0;
+    const auto segment = static_cast<size_t>(it - m_checkpoints.begin() - 1);
+    const auto &checkpoint = m_checkpoints[segment];
+    const auto segment_step = step(segment);
+    return checkpoint.index + (value - checkpoint.value + segment_step - 1) / segment_step;
+  }
+
+  void clear() {
+    m_checkpoints.clear();
+    m_hint = 0;
+  }
+
+  void push_back(IndexType value) {
+    const auto count = m_checkpoints.size();
+    if (count >= 2) {
+      auto &last = m_checkpoints.back();
+      const auto &prev = m_checkpoints[count - 2];
+      if (last.value - prev.value == (value - last.value) * (last.index - prev.index)) {
+        last = {last.index + 1, value};
+        return;
+      }
+    }
+    m_checkpoints.push_back({size(), value});
+  }
+
+  // Append `count` values `first`, `first + 1`, ...
+  void push_back_run(IndexType first, IndexType count) {
+    if (count <= 0)
+      return;
+    push_back(first);
+    extend(count - 1, 1);
+  }
+
+  void pop_back() {
+    const auto count = m_checkpoints.size();
+    if (count >= 2 && m_checkpoints[count - 2].index == m_checkpoints.back().index - 1)
+      m_checkpoints.pop_back();
+    else if (count >= 2)
+      m_checkpoints.back() = {m_checkpoints.back().index - 1, m_checkpoints.back().value - step(count - 2)};
+    else
+      m_checkpoints.clear();
+    m_hint = 0;
+  }
+
+  void append(const SparseMapping &other) {
+    for (size_t i = 0; i < other.m_checkpoints.size(); ++i) {
+      if (i == 0)
+        push_back(other.m_checkpoints[i].value);
+      else
+        extend(other.m_checkpoints[i].index - other.m_checkpoints[i - 1].index, other.step(i - 1));
+    }
+  }
+
+  // Values with indices in [first, last)
+  SparseMapping subrange(IndexType first, IndexType last) const {
+    SparseMapping result;
+    if (first >= last)
+      return result;
+    result.push_back((*this)[first]);
+    for (auto segment = find_segment(first); first < last - 1; ++segment) {
+      const auto segment_end = std::min(m_checkpoints[segment + 1].index, last - 1);
+      result.extend(segment_end - first, step(segment));
+      first = segment_end;
+    }
+    return result;
+  }
+
+  void erase_front(IndexType count) { *this = subrange(count, size()); }
+  void truncate(IndexType count) { *this = subrange(0, count); }
+
+  // Add `offset` to every value
+  void shift(IndexType offset) {
+    for (auto &checkpoint : m_checkpoints)
+      checkpoint.value += offset;
+  }
+
+  bool operator==(const SparseMapping &other) const {
+    if (size() != other.size())
+      return false;
+    for (IndexType i = 0; i < size(); ++i)
+      if ((*this)[i] != other[i])
+        return false;
+    return true;
+  }
+
+private:
+  struct Checkpoint {
+    IndexType index;
+    IndexType value;
+  };
+
+  IndexType step(size_t segment) const {
+    const auto &first = m_checkpoints[segment];
+    const auto &second = m_checkpoints[segment + 1];
+    return (second.value - first.value) / (second.index - first.index);
+  }
+
+  // Continue with `count` values changing by `value_step` from the last one
+  void extend(IndexType count, IndexType value_step) {
+    if (count <= 0)
+      return;
+    push_back(back() + value_step);
+    auto &last = m_checkpoints.back();
+    last = {last.index + count - 1, last.value + (count - 1) * value_step};
+  }
+
+  // Last checkpoint with index not greater than `index`, sequential lookups don't need a binary search
+  size_t find_segment(IndexType index) const {
+    const auto is_inside = [&](size_t segment) {
+      return segment < m_checkpoints.size() && m_checkpoints[segment].index <= index && (segment + 1 == m_checkpoints.size() || index < m_checkpoints[segment + 1].index);
+    };
+    if (!is_inside(m_hint) && !is_inside(++m_hint))
+      m_hint = static_cast<size_t>(std::upper_bound(m_checkpoints.begin(), m_checkpoints.end(), index, [](IndexType value, const Checkpoint &checkpoint) { return value < checkpoint.index; }) -
+                                   m_checkpoints.begin() - 1);
+    return m_hint;
+  }
+
+private:
+  std::vector<Checkpoint> m_checkpoints;
+  mutable size_t m_hint = 0;
+};
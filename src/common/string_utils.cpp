@@ -14,6 +14,8 @@
 
 #include "string_utils.h"
 
+#include "CharClassTable.h"
+
 #include <algorithm>
 #include <cassert>
 #include <cctype>
@@ -97,9 +99,9 @@ wchar_t make_lower(wchar_t c) {
 }
 
 bool is_upper(wchar_t c) {
-  return IsCharUpper(c);
+  return CharClassTable::system().is_upper(c);
 }
 
 bool is_lower(wchar_t c) {
-  return IsCharLower(c);
+  return CharClassTable::system().is_lower(c);
 }
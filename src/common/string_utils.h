@@ -14,45 +14,72 @@
 
 #pragma once
 
+#include "DelimiterSet.h"
+#include "utf8.h"
 #include "plugin/Constants.h"
 
+#include <bit>
+#include <functional>
+#include <iterator>
+#include <ranges>
+
 wchar_t make_upper(wchar_t c);
 wchar_t make_lower(wchar_t c);
 bool is_upper(wchar_t c);
 bool is_lower(wchar_t c);
 
+namespace detail {
+// Forward iterator over tokens which are found one by one by `TokenizerType::next_token`
+template <typename TokenizerType> class TokenIterator {
+  using Cursor = typename TokenizerType::Cursor;
+  using Token = decltype(std::declval<const TokenizerType &>().next_token(std::declval<Cursor &>()));
+
+public:
+  using value_type = Token;
+  using difference_type = std::ptrdiff_t;
+  using iterator_concept = std::forward_iterator_tag;
+
+  TokenIterator() = default;
+  explicit TokenIterator(const TokenizerType &tokenizer) : m_tokenizer(&tokenizer) { ++*this; }
+
+  Token operator*() const { return m_token; }
+  TokenIterator &operator++() {
+    m_token = m_tokenizer->next_token(m_cursor);
+    return *this;
+  }
+  TokenIterator operator++(int) {
+    auto copy = *this;
+    ++*this;
+    return copy;
+  }
+  bool operator==(const TokenIterator &other) const { return m_token.data() == other.m_token.data() && m_token.length() == other.m_token.length(); }
+  bool operator==(std::default_sentinel_t) const { return m_token.empty(); }
+
+private:
+  const TokenizerType *m_tokenizer = nullptr;
+  Cursor m_cursor{};
+  Token m_token;
+};
+} // namespace detail
+
 template <typename IsDelimiterType> class Tokenizer {
+  // could be std::reference_wrapper to avoid copying of predicate
+  using DelimiterPredicate = std::remove_cvref_t<std::unwrap_reference_t<IsDelimiterType>>;
+
 public:
   Tokenizer(const std::wstring_view &target, const IsDelimiterType &is_delimiter, bool split_camel_case)
     : m_target(target), m_is_delimiter(is_delimiter), m_split_camel_case(split_camel_case) {
   }
 
+  using TokenIterator = detail::TokenIterator<Tokenizer>;
+
+  // Tokens are found lazily one by one, tokenizer should outlive the range
+  auto tokens() const { return std::ranges::subrange(TokenIterator(*this), std::default_sentinel); }
+
   std::vector<std::wstring_view> get_all_tokens() const {
-    int token_begin = 0, token_end = -1;
     std::vector<std::wstring_view> ret;
-
-    auto finalize_word = [&]() {
-      if (token_begin < token_end) {
-        ret.push_back(m_target.substr(token_begin, token_end - token_begin));
-        ++token_end;
-      }
-    };
-
-    for (int i = 0; i < static_cast<int>(m_target.size()); ++i) {
-      if (!m_is_delimiter(m_target[i])) {
-        if (m_split_camel_case && i > token_begin && is_upper(m_target[i]) &&
-            (is_lower(m_target[i - 1]) || (i < static_cast<TextPosition>(m_target.length()) - 1 && is_lower(m_target[i + 1])))) {
-          token_end = i;
-          finalize_word();
-          token_begin = i;
-        } else
-          token_end = i + 1;
-      } else {
-        finalize_word();
-        token_begin = i + 1;
-      }
-    }
-    finalize_word();
+    for (auto token : tokens())
+      ret.push_back(token);
     return ret;
   }
 
@@ -89,13 +116,151 @@ public:
   }
 
 private:
+  friend TokenIterator;
+
+  struct Cursor {
+    TextPosition position = 0;
+    // end of the run of non-delimiters containing `position`, -1 if it's not known yet
+    TextPosition run_end = -1;
+    // bit i is set if character at `mask_begin + i` is a delimiter
+    uint32_t delimiter_mask = 0;
+    TextPosition mask_begin = 0;
+    TextPosition mask_length = 0;
+  };
+
+  static constexpr TextPosition mask_block_size = 32;
+
+  void load_delimiter_mask(Cursor &cursor, TextPosition from) const {
+    cursor.mask_begin = from;
+    cursor.mask_length = std::min(mask_block_size, static_cast<TextPosition>(m_target.length()) - from);
+    const DelimiterPredicate &is_delimiter = m_is_delimiter;
+    if constexpr (requires(const DelimiterPredicate &predicate, const wchar_t *block) { predicate.classify_block(block); }) {
+      static_assert(DelimiterPredicate::block_size == mask_block_size);
+      if (cursor.mask_length == mask_block_size) {
+        cursor.delimiter_mask = is_delimiter.classify_block(m_target.data() + from);
+        return;
+      }
+    }
+    cursor.delimiter_mask = 0;
+    for (TextPosition i = 0; i < cursor.mask_length; ++i)
+      cursor.delimiter_mask |= static_cast<uint32_t>(is_delimiter(m_target[from + i])) << i;
+  }
+
+  // position of the first delimiter (or non-delimiter) at or after `from`, length of target if there's none
+  TextPosition find_first(Cursor &cursor, TextPosition from, bool delimiter) const {
+    const auto length = static_cast<TextPosition>(m_target.length());
+    while (from < length) {
+      if (from < cursor.mask_begin || from >= cursor.mask_begin + cursor.mask_length)
+        load_delimiter_mask(cursor, from);
+      const auto offset = from - cursor.mask_begin;
+      // bits past the end of mask don't matter, found position is checked against mask length
+      const auto found = offset + std::countr_zero((delimiter ? cursor.delimiter_mask : ~cursor.delimiter_mask) >> offset);
+      if (found < cursor.mask_length)
+        return cursor.mask_begin + found;
+      from = cursor.mask_begin + cursor.mask_length;
+    }
+    return length;
+  }
+
+  // empty if there are no tokens left
+  std::wstring_view next_token(Cursor &cursor) const {
+    if (cursor.run_end < 0) {
+      cursor.position = find_first(cursor, cursor.position, false);
+      if (cursor.position == static_cast<TextPosition>(m_target.length()))
+        return {};
+      cursor.run_end = find_first(cursor, cursor.position, true);
+    }
+    const auto begin = cursor.position;
+    auto end = cursor.run_end;
+    if (m_split_camel_case) {
+      for (auto i = begin + 1; i < end; ++i) {
+        if (is_camel_case_boundary(i)) {
+          end = i;
+          break;
+        }
+      }
+    }
+    cursor.position = end;
+    if (end == cursor.run_end)
+      cursor.run_end = -1;
+    return m_target.substr(begin, end - begin);
+  }
+
+  bool is_camel_case_boundary(TextPosition i) const {
+    return is_upper(m_target[i]) && (is_lower(m_target[i - 1]) || (i < static_cast<TextPosition>(m_target.length()) - 1 && is_lower(m_target[i + 1])));
+  }
+
   std::wstring_view m_target;
   IsDelimiterType m_is_delimiter;
   bool m_split_camel_case;
 };
 
+// Same as Tokenizer but works directly on UTF-8 text, tokens are byte ranges of it
+template <typename IsDelimiterType> class Utf8Tokenizer {
+public:
+  Utf8Tokenizer(std::string_view target, const IsDelimiterType &is_delimiter, bool split_camel_case)
+    : m_target(target), m_is_delimiter(is_delimiter), m_split_camel_case(split_camel_case) {
+  }
+
+  using TokenIterator = detail::TokenIterator<Utf8Tokenizer>;
+
+  // Tokens are found lazily one by one, tokenizer should outlive the range
+  auto tokens() const { return std::ranges::subrange(TokenIterator(*this), std::default_sentinel); }
+
+  std::vector<std::string_view> get_all_tokens() const {
+    std::vector<std::string_view> ret;
+    for (auto token : tokens())
+      ret.push_back(token);
+    return ret;
+  }
+
+private:
+  friend TokenIterator;
+
+  // byte offset where search for the next token starts
+  using Cursor = TextPosition;
+
+  wchar_t decode(const char *&it) const {
+    if (static_cast<unsigned char>(*it) < 0x80)
+      return static_cast<wchar_t>(*it++);
+    return utf8_decode_bmp_char(it, m_target.data() + m_target.length());
+  }
+
+  // empty if there are no tokens left
+  std::string_view next_token(Cursor &cursor) const {
+    const auto end = m_target.data() + m_target.length();
+    auto it = m_target.data() + cursor;
+    const char *token_begin = nullptr;
+    wchar_t prev = 0;
+    do {
+      if (it == end)
+        return {};
+      token_begin = it;
+      prev = decode(it);
+    } while (m_is_delimiter(prev));
+
+    auto token_end = it;
+    while (token_end != end) {
+      auto next = token_end;
+      const auto c = decode(next);
+      if (m_is_delimiter(c) || (m_split_camel_case && is_upper(c) && (is_lower(prev) || (next != end && is_lower(peek(next))))))
+        break;
+      prev = c;
+      token_end = next;
+    }
+    cursor = token_end - m_target.data();
+    return {token_begin, static_cast<size_t>(token_end - token_begin)};
+  }
+
+  wchar_t peek(const char *it) const { return decode(it); }
+
+  std::string_view m_target;
+  IsDelimiterType m_is_delimiter;
+  bool m_split_camel_case;
+};
+
 inline auto make_delimiter_tokenizer(std::wstring_view target, std::wstring_view delimiters, bool split_camel_case = false) {
-  return Tokenizer(target, [=](wchar_t c) { return delimiters.find(c) != std::string_view::npos; }, split_camel_case);
+  return Tokenizer(target, DelimiterSet(delimiters), split_camel_case);
 }
 
 namespace detail {
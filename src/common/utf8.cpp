@@ -14,6 +14,8 @@
 
 #include "utf8.h"
 
+#include <algorithm>
+
 bool utf8_is_lead(char c) {
   return (((c & 0x80) == 0)                          // 0xxxxxxx
           || ((c & 0xC0) == 0xC0 && (c & 0x20) == 0) // 110xxxxx
@@ -96,3 +98,64 @@ size_t utf8_length(const char *string) {
   }
   return size;
 }
+
+wchar_t utf8_decode_bmp_char(const char *&it, const char *end) {
+  const auto begin = reinterpret_cast<const unsigned char *>(it);
+  const auto length = std::min<ptrdiff_t>(utf8_symbol_len(*it), end - it);
+  it += length;
+  auto is_cont = [&](ptrdiff_t index) { return (begin[index] & 0xC0) == 0x80; };
+  if (begin[0] < 0x80)
+    return begin[0];
+  if (length == 2 && (begin[0] & 0xE0) == 0xC0 && is_cont(1)) {
+    const auto value = ((begin[0] & 0x1F) << 6) | (begin[1] & 0x3F);
+    if (value >= 0x80)
+      return static_cast<wchar_t>(value);
+  }
+  if (length == 3 && (begin[0] & 0xF0) == 0xE0 && is_cont(1) && is_cont(2)) {
+    const auto value = ((begin[0] & 0x0F) << 12) | ((begin[1] & 0x3F) << 6) | (begin[2] & 0x3F);
+    if (value >= 0x800 && (value < 0xD800 || value > 0xDFFF))
+      return static_cast<wchar_t>(value);
+  }
+  if (length == 4 && (begin[0] & 0xF8) == 0xF0 && is_cont(1) && is_cont(2) && is_cont(3))
+    return 0;
+  return 0xFFFD;
+}
+
+std::wstring utf8_decode_bmp(std::string_view str) {
+  std::wstring result;
+  result.reserve(str.length());
+  const auto end = str.data() + str.length();
+  for (auto it = str.data(); it != end;)
+    result.push_back(utf8_decode_bmp_char(it, end));
+  return result;
+}
+
+std::string utf8_encode(std::wstring_view str) {
+  std::string result;
+  result.reserve(str.length());
+  for (size_t i = 0; i < str.length(); ++i) {
+    uint32_t c = str[i];
+    if (c >= 0xD800 && c <= 0xDFFF) {
+      if (c > 0xDBFF || i + 1 == str.length() || str[i + 1] < 0xDC00 || str[i + 1] > 0xDFFF)
+        continue;
+      c = 0x10000 + ((c - 0xD800) << 10) + (str[i + 1] - 0xDC00);
+      ++i;
+    }
+    if (c < 0x80)
+      result.push_back(static_cast<char>(c));
+    else if (c < 0x800) {
+      result.push_back(static_cast<char>(0xC0 | (c >> 6)));
+      result.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    } else if (c < 0x10000) {
+      result.push_back(static_cast<char>(0xE0 | (c >> 12)));
+      result.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+      result.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    } else {
+      result.push_back(static_cast<char>(0xF0 | (c >> 18)));
+      result.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+      result.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+      result.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    }
+  }
+  return result;
+}
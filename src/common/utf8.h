@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <string>
+#include <string_view>
+
 char *utf8_dec(const char *string, const char *current);
 char *utf8_chr(const char *s, const char *sfc);
 int utf8_symbol_len(char c);
@@ -23,3 +26,9 @@ const char *utf8_pbrk(const char *s, const char *set);
 size_t utf8_length(const char *string);
 bool utf8_is_lead(char c);
 bool utf8_is_cont(char c);
+// Decodes character at `it` and moves `it` past it, same as done for MappedWstring:
+// characters outside of BMP are decoded as 0 and invalid sequences as U+FFFD
+wchar_t utf8_decode_bmp_char(const char *&it, const char *end);
+std::wstring utf8_decode_bmp(std::string_view str);
+// Unpaired surrogates are skipped
+std::string utf8_encode(std::wstring_view str);
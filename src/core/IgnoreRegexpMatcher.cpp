@@ -0,0 +1,48 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "IgnoreRegexpMatcher.h"
+
+IgnoreRegexpMatcher::IgnoreRegexpMatcher(const std::wstring &pattern) {
+  if (pattern.empty())
+    return;
+  std::wregex regex(pattern);
+  m_regex = LinearRegex::compile(pattern);
+  if (!m_regex)
+    m_fallback = std::move(regex);
+}
+
+bool IgnoreRegexpMatcher::matches(std::wstring_view word) const {
+  if (!m_regex && !m_fallback)
+    return false;
+  std::wstring key(word);
+  if (auto it = m_cache.find(key); it != m_cache.end())
+    return it->second;
+  // Simple bound instead of proper eviction, same as for speller verdicts
+  if (m_cache.size() >= max_cache_size)
+    m_cache.clear();
+  auto result = match_uncached(word);
+  m_cache.emplace(std::move(key), result);
+  return result;
+}
+
+bool IgnoreRegexpMatcher::uses_fallback() const {
+  return m_fallback.has_value();
+}
+
+bool IgnoreRegexpMatcher::match_uncached(std::wstring_view word) const {
+  if (m_regex)
+    return m_regex->full_match(word);
+  return std::regex_match(word.begin(), word.end(), *m_fallback);
+}
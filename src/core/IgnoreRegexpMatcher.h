@@ -0,0 +1,44 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include "common/LinearRegex.h"
+
+#include <optional>
+#include <regex>
+#include <string>
+#include <unordered_map>
+
+// Matcher for "Ignore words matching regexp" option.
+// Pattern is validated by std::wregex but matched by LinearRegex whenever it supports the syntax, std::wregex is used only as a fallback.
+// Results are remembered per word since the same words keep repeating in text. Not thread safe.
+class IgnoreRegexpMatcher {
+public:
+  // Matches nothing
+  IgnoreRegexpMatcher() = default;
+  // throws std::regex_error if pattern is invalid
+  explicit IgnoreRegexpMatcher(const std::wstring &pattern);
+  bool matches(std::wstring_view word) const;
+  bool uses_fallback() const;
+
+private:
+  bool match_uncached(std::wstring_view word) const;
+
+private:
+  static constexpr size_t max_cache_size = 1 << 14;
+  std::optional<LinearRegex> m_regex;
+  std::optional<std::wregex> m_fallback;
+  mutable std::unordered_map<std::wstring, bool> m_cache;
+};
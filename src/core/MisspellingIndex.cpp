@@ -0,0 +1,87 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "MisspellingIndex.h"
+
+void MisspellingIndex::on_insert(TextPosition pos, TextPosition length) {
+  for (auto &range : m_misspellings) {
+    if (range[0] >= pos)
+      range[0] += length;
+    if (range[1] > pos)
+      range[1] += length;
+  }
+  m_checked.on_insert(pos, length);
+}
+
+void MisspellingIndex::on_delete(TextPosition pos, TextPosition length) {
+  auto shift = [&](TextPosition &value) {
+    if (value >= pos + length)
+      value -= length;
+    else if (value > pos)
+      value = pos;
+  };
+  for (auto &range : m_misspellings) {
+    shift(range[0]);
+    shift(range[1]);
+  }
+  std::erase_if(m_misspellings, [](const Range &range) { return range[0] >= range[1]; });
+  m_checked.on_delete(pos, length);
+}
+
+void MisspellingIndex::invalidate(TextPosition begin, TextPosition end) {
+  erase_overlapping(begin, end);
+  m_checked.remove(begin, end);
+}
+
+void MisspellingIndex::set_checked(TextPosition begin, TextPosition end, const std::vector<Range> &misspellings) {
+  erase_overlapping(begin, end);
+  auto it = std::lower_bound(m_misspellings.begin(), m_misspellings.end(), begin,
+                             [](const Range &range, TextPosition pos) { return range[0] < pos; });
+  m_misspellings.insert(it, misspellings.begin(), misspellings.end());
+  m_checked.add(begin, end);
+}
+
+std::optional<TextPosition> MisspellingIndex::first_unchecked_position(TextPosition doc_length) const {
+  auto &intervals = m_checked.intervals();
+  if (intervals.empty() || intervals.front().begin > 0)
+    return doc_length > 0 ? std::optional<TextPosition>{0} : std::nullopt;
+  auto pos = intervals.front().end;
+  if (pos >= doc_length)
+    return std::nullopt;
+  return pos;
+}
+
+bool MisspellingIndex::is_complete(TextPosition doc_length) const {
+  return !first_unchecked_position(doc_length);
+}
+
+std::optional<MisspellingIndex::Range> MisspellingIndex::next_after(TextPosition pos) const {
+  auto it = std::upper_bound(m_misspellings.begin(), m_misspellings.end(), pos,
+                             [](TextPosition pos, const Range &range) { return pos < range[1]; });
+  if (it == m_misspellings.end())
+    return std::nullopt;
+  return *it;
+}
+
+std::optional<MisspellingIndex::Range> MisspellingIndex::prev_before(TextPosition pos) const {
+  auto it = std::lower_bound(m_misspellings.begin(), m_misspellings.end(), pos,
+                             [](const Range &range, TextPosition pos) { return range[1] < pos; });
+  if (it == m_misspellings.begin())
+    return std::nullopt;
+  return *std::prev(it);
+}
+
+void MisspellingIndex::erase_overlapping(TextPosition begin, TextPosition end) {
+  std::erase_if(m_misspellings, [&](const Range &range) { return range[0] < end && range[1] > begin; });
+}
@@ -0,0 +1,51 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include "common/IntervalSet.h"
+#include "plugin/Constants.h"
+
+#include <array>
+#include <optional>
+#include <vector>
+
+// Sorted list of misspelled ranges of a single document together with the set of positions which were already checked.
+// Allows navigation and reports to be answered without rechecking whole document.
+class MisspellingIndex {
+public:
+  using Range = std::array<TextPosition, 2>;
+
+  void on_insert(TextPosition pos, TextPosition length);
+  void on_delete(TextPosition pos, TextPosition length);
+  // forget everything known about [begin, end)
+  void invalidate(TextPosition begin, TextPosition end);
+  // replace knowledge about [begin, end) with results of its check, `misspellings` should be sorted
+  void set_checked(TextPosition begin, TextPosition end, const std::vector<Range> &misspellings);
+
+  std::optional<TextPosition> first_unchecked_position(TextPosition doc_length) const;
+  bool is_complete(TextPosition doc_length) const;
+  // first misspelling ending after `pos`
+  std::optional<Range> next_after(TextPosition pos) const;
+  // last misspelling ending before `pos`
+  std::optional<Range> prev_before(TextPosition pos) const;
+  const std::vector<Range> &misspellings() const { return m_misspellings; }
+
+private:
+  void erase_overlapping(TextPosition begin, TextPosition end);
+
+private:
+  std::vector<Range> m_misspellings; // sorted and non-overlapping, so ends are sorted as well
+  IntervalSet<TextPosition> m_checked;
+};
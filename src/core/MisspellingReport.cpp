@@ -0,0 +1,67 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "MisspellingReport.h"
+
+namespace {
+std::wstring fold_case(std::wstring_view word) {
+  std::wstring result(word);
+  if (!result.empty())
+    CharUpperBuff(result.data(), static_cast<DWORD>(result.size()));
+  return result;
+}
+} // namespace
+
+void MisspellingReport::add(std::wstring_view word, TextPosition position) {
+  auto folded = fold_case(word);
+  auto [it, inserted] = m_entry_by_folded_word.try_emplace(folded, m_entries.size());
+  if (inserted) {
+    m_entries.push_back({std::wstring(word), 0, position});
+    m_folded_words.push_back(std::move(folded));
+  }
+  ++m_entries[it->second].count;
+}
+
+bool MisspellingReport::empty() const {
+  return m_entries.empty();
+}
+
+std::vector<size_t> MisspellingReport::order_by_word() const {
+  std::vector<size_t> order(m_entries.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) { return m_folded_words[lhs] < m_folded_words[rhs]; });
+  return order;
+}
+
+std::vector<MisspellingReport::Entry> MisspellingReport::entries_by_word() const {
+  std::vector<Entry> result;
+  result.reserve(m_entries.size());
+  for (auto index : order_by_word())
+    result.push_back(m_entries[index]);
+  return result;
+}
+
+std::vector<MisspellingReport::Entry> MisspellingReport::entries_by_count() const {
+  auto result = m_entries;
+  // entries are stored in order of first occurrence
+  std::stable_sort(result.begin(), result.end(), [](const Entry &lhs, const Entry &rhs) { return lhs.count > rhs.count; });
+  return result;
+}
+
+std::wstring MisspellingReport::to_string() const {
+  std::wstring str;
+  for (auto index : order_by_word())
+    str += m_entries[index].word + L'\n';
+  return str;
+}
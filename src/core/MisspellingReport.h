@@ -0,0 +1,49 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include "npp/EditorInterface.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Misspellings of a document aggregated by word, words differing only in case are considered the same
+class MisspellingReport {
+public:
+  struct Entry {
+    std::wstring word; // as spelled in its first occurrence
+    size_t count = 0;
+    TextPosition first_position = 0;
+  };
+
+  // should be called in document order
+  void add(std::wstring_view word, TextPosition position);
+  bool empty() const;
+  // ordered case-insensitively by word
+  std::vector<Entry> entries_by_word() const;
+  // most frequent first, ties ordered by first position
+  std::vector<Entry> entries_by_count() const;
+  // unique words one per line ordered case-insensitively
+  std::wstring to_string() const;
+
+private:
+  std::vector<size_t> order_by_word() const;
+
+private:
+  std::vector<Entry> m_entries;
+  std::vector<std::wstring> m_folded_words;
+  std::unordered_map<std::wstring, size_t> m_entry_by_folded_word;
+};
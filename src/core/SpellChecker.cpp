@@ -16,6 +16,8 @@
 
 #include "SpellCheckerHelpers.h"
 #include "common/Utility.h"
+#include "common/utf8.h"
+#include "npp/DocumentTextWindow.h"
 #include "npp/EditorInterface.h"
 #include "npp/NppInterface.h"
 #include "plugin/Constants.h"
@@ -27,10 +29,45 @@
 
 #include <ranges>
 
+namespace {
+using TextRange = std::array<TextPosition, 2>;
+constexpr TextPosition search_block_length = 4096;
+constexpr TextPosition check_chunk_size = 32 * 1024;
+// maximum number of words passed to speller at once
+constexpr size_t speller_batch_size = 256;
+
+// Parts of sorted disjoint ranges `lhs` not covered by sorted disjoint ranges `rhs`
+std::vector<TextRange> subtract_ranges(const std::vector<TextRange> &lhs, const std::vector<TextRange> &rhs) {
+  std::vector<TextRange> result;
+  size_t first = 0;
+  for (auto [begin, end] : lhs) {
+    while (first < rhs.size() && rhs[first][1] <= begin)
+      ++first;
+    for (auto i = first; i < rhs.size() && rhs[i][0] < end; ++i) {
+      if (rhs[i][0] > begin)
+        result.push_back({begin, rhs[i][0]});
+      begin = std::max(begin, rhs[i][1]);
+    }
+    if (begin < end)
+      result.push_back({begin, end});
+  }
+  return result;
+}
+} // namespace
+
+class SpellerWordData {
+public:
+  std::wstring_view token; // empty for words checked in UTF-8 text
+  WordForSpeller word_for_speller;
+  TextPosition word_start;
+  TextPosition word_end;
+  bool is_correct;
+};
+
 SpellChecker::SpellChecker(const Settings *settings, EditorInterface &editor, const SpellerContainer &speller_container)
   : m_settings(*settings), m_editor(editor), m_speller_container(speller_container) {
   m_settings.settings_changed.connect([this] { on_settings_changed(); });
-  m_speller_container.speller_status_changed.connect([this] { recheck_visible_both_views(); });
+  m_speller_container.speller_status_changed.connect([this] { on_speller_status_changed(); });
   on_settings_changed();
 }
 
@@ -39,12 +76,48 @@ SpellChecker::~SpellChecker() = default;
 void SpellChecker::recheck_visible_both_views() {
   print_to_log(L"void SpellChecker::recheck_visible_both_views()", m_editor.get_editor_hwnd());
   auto view_count = m_editor.get_view_count();
+  std::vector<std::wstring> paths;
+  for (int view_index = 0; view_index < view_count; ++view_index) {
+    TARGET_VIEW_BLOCK(m_editor, view_index);
+    paths.push_back(m_editor.active_document_path());
+  }
+  if (view_count == 2 && !paths[0].empty() && paths[0] == paths[1])
+    return recheck_visible_shared_document();
+
   for (int view_index = 0; view_index < view_count; ++view_index) {
     TARGET_VIEW_BLOCK(m_editor, view_index);
     recheck_visible();
   }
 }
 
+void SpellChecker::recheck_visible_shared_document() {
+  // underlines belong to the document, so visible text of both views is checked once with overlapping parts merged
+  std::vector<MappedWstring> texts;
+  std::vector<std::array<TextPosition, 2>> visible_line_ranges;
+  for (int view_index = 0; view_index < 2; ++view_index) {
+    TARGET_VIEW_BLOCK(m_editor, view_index);
+    if (!prepare_visible_recheck())
+      return;
+    auto [first_line, last_line] = get_visible_line_range();
+    collect_visible_texts(first_line, last_line, texts);
+    visible_line_ranges.push_back({first_line, last_line});
+  }
+
+  TARGET_VIEW_BLOCK(m_editor, 0);
+  schedule_prefetch(visible_line_ranges);
+  std::ranges::sort(texts, {}, [](const MappedWstring &text) { return text.to_original_index(0); });
+  std::vector<MappedWstring> merged;
+  for (auto &text : texts) {
+    if (!merged.empty() && text.to_original_index(0) < merged.back().original_length()) {
+      if (text.original_length() > merged.back().original_length())
+        merged.back() = m_editor.get_mapped_wstring_range(merged.back().to_original_index(0), text.original_length());
+      continue;
+    }
+    merged.push_back(std::move(text));
+  }
+  underline_misspelled_words(std::move(merged), true);
+}
+
 void SpellChecker::recheck_visible_on_active_view() {
   ACTIVE_VIEW_BLOCK(m_editor);
   recheck_visible();
@@ -53,39 +126,39 @@ void SpellChecker::recheck_visible_on_active_view() {
 void SpellChecker::find_next_mistake() {
   ACTIVE_VIEW_BLOCK(m_editor);
   auto current_position = m_editor.get_current_pos();
-  auto doc_length = m_editor.get_active_document_length();
-  auto iterator_pos = prev_token_begin_in_document(current_position);
+  if (auto index = complete_misspelling_index()) {
+    auto mb_range = index->next_after(current_position);
+    if (!mb_range)
+      mb_range = index->next_after(0);
+    if (mb_range)
+      m_editor.set_selection((*mb_range)[0], (*mb_range)[1]);
+    return;
+  }
+
+  const auto doc_length = m_editor.get_active_document_length();
+  DocumentTextWindow window(m_editor, prev_token_begin_in_document(current_position));
   bool full_check = false;
 
   while (true) {
-    auto from = iterator_pos;
-    auto to = iterator_pos + 4096;
-    int ignore_offsetting = 0;
-    if (to > doc_length) {
-      ignore_offsetting = 1;
-      to = doc_length;
-    }
-    if (from < to) {
-      auto text = m_editor.get_mapped_wstring_range(from, to);
-      auto index = static_cast<TextPosition>(text.str.size());
-      if (to != doc_length && next_token_end(text.str, to) == index)
-        index = prev_token_begin(text.str, index - 1);
-      text.str.erase(index, text.str.size() - index);
-      if (auto mb_positions = find_first_misspelling(text, current_position)) {
+    window.extend_right(search_block_length);
+    auto index = window.length();
+    // last token could continue after the window, it's left for the next block
+    if (window.end() < doc_length)
+      index = prev_token_begin(window.str(), index - 1);
+    if (index > 0) {
+      if (auto mb_positions = find_first_misspelling(window.take_front(index), current_position)) {
         auto &pos = *mb_positions;
         m_editor.set_selection(pos[0], pos[1]);
         break;
       }
-
-      iterator_pos += (text.to_original_index(index) - from);
     }
 
-    if (to == doc_length) {
+    if (window.end() == doc_length && window.length() == 0) {
       if (full_check)
         break;
 
       current_position = 0;
-      iterator_pos = 0;
+      window.reset(0);
       full_check = true;
     }
   }
@@ -95,48 +168,55 @@ void SpellChecker::find_prev_mistake() {
   ACTIVE_VIEW_BLOCK(m_editor);
   auto current_position = m_editor.get_current_pos();
   auto doc_length = m_editor.get_active_document_length();
+  if (auto index = complete_misspelling_index()) {
+    auto mb_range = index->prev_before(current_position);
+    if (!mb_range)
+      mb_range = index->prev_before(doc_length + 1);
+    if (mb_range)
+      m_editor.set_selection((*mb_range)[0], (*mb_range)[1]);
+    return;
+  }
 
-  auto iterator_pos = next_token_end_in_document(current_position);
+  DocumentTextWindow window(m_editor, next_token_end_in_document(current_position));
   bool full_check = false;
 
   while (true) {
-    auto from = iterator_pos - 4096;
-    auto to = iterator_pos;
-    int ignore_offsetting = 0;
-    if (from < 0) {
-      from = 0;
-      ignore_offsetting = 1;
-    }
-
-    if (from < to) {
-      auto text = m_editor.get_mapped_wstring_range(from, to);
-      auto offset = next_token_end(text.str, 0);
-      if (auto mb_positions = find_last_misspelling(text, current_position)) {
+    window.extend_left(search_block_length);
+    TextPosition index = 0;
+    // first token could continue before the window, it's left for the next block
+    if (window.begin() > 0)
+      index = next_token_end(window.str(), 0);
+    if (index < window.length()) {
+      if (auto mb_positions = find_last_misspelling(window.take_back(index), current_position)) {
         auto &pos = *mb_positions;
         m_editor.set_selection(pos[0], pos[1]);
         break;
       }
+    }
 
-      iterator_pos -= (4096 - (text.to_original_index(offset) - from));
-    } else
-      --iterator_pos;
-
-    if (iterator_pos < 0) {
+    if (window.begin() == 0 && window.length() == 0) {
       if (full_check)
         break;
 
       current_position = doc_length + 1;
-      iterator_pos = doc_length;
+      window.reset(doc_length);
       full_check = true;
     }
   }
 }
 
 WordForSpeller SpellChecker::to_word_for_speller(std::wstring_view word) const {
+  return to_word_for_speller(word, *(word.data() + word.length()) == '.', {});
+}
+
+WordForSpeller SpellChecker::to_word_for_speller(std::wstring_view word, bool ends_with_dot, std::string_view utf8_word) const {
   WordForSpeller res;
-  res.data.ends_with_dot = *(word.data() + word.length()) == '.';
+  res.data.ends_with_dot = ends_with_dot;
   res.str = word;
   SpellCheckerHelpers::apply_word_conversions(m_settings, res.str);
+  if (m_speller_container.active_speller().accepts_utf8_words())
+    // bytes from document are used as is unless conversions changed the word
+    res.utf8 = !utf8_word.empty() && res.str == word ? std::string(utf8_word) : utf8_encode(res.str);
   return res;
 }
 
@@ -159,69 +239,117 @@ void SpellChecker::refresh_underline_style() {
 }
 
 void SpellChecker::on_settings_changed() {
+  ++m_common_generation;
+  m_verdict_cache.clear();
+  clear_misspelling_indices();
   refresh_underline_style();
   recheck_visible_both_views();
 }
 
-void SpellChecker::create_word_underline(TextPosition start, TextPosition end) const {
-  m_editor.set_current_indicator(spell_check_indicator_id);
-  m_editor.indicator_fill_range(start, end);
+void SpellChecker::on_speller_status_changed() {
+  ++m_common_generation;
+  m_verdict_cache.clear();
+  clear_misspelling_indices();
+  recheck_visible_both_views();
 }
 
-void SpellChecker::remove_underline(TextPosition start, TextPosition end) const {
+void SpellChecker::update_underlines(TextPosition from, TextPosition to, const std::vector<TextRange> &underlined) const {
+  auto current = m_editor.get_indicator_ranges(spell_check_indicator_id, from, to);
+  auto to_clear = subtract_ranges(current, underlined);
+  auto to_fill = subtract_ranges(underlined, current);
+  if (to_clear.empty() && to_fill.empty())
+    return;
+
   m_editor.set_current_indicator(spell_check_indicator_id);
-  m_editor.indicator_clear_range(start, end);
+  for (auto [begin, end] : to_clear)
+    m_editor.indicator_clear_range(begin, end);
+  for (auto [begin, end] : to_fill)
+    m_editor.indicator_fill_range(begin, end);
 }
 
 TextPosition SpellChecker::prev_token_begin_in_document(TextPosition start) const {
+  DocumentTextWindow window(m_editor, start);
+  return prev_token_begin_in_document(window, start);
+}
+
+TextPosition SpellChecker::prev_token_begin_in_document(DocumentTextWindow &window, TextPosition start) const {
+  window.extend_to(start);
+  // character at `start` is required as well
+  if (window.end() <= start)
+    window.extend_right(1);
+
   TextPosition shift = 15;
-  auto prev_start = start + 1;
-  while (start > 0) {
-    start = std::max(start - shift, 0_sz);
-    auto mapped_str = m_editor.get_mapped_wstring_range(start, prev_start);
+  while (true) {
+    auto index = std::min(window.from_original_index(start), window.length() - 1);
     // finding any start before start which starts a token
-    auto index = prev_token_begin(mapped_str.str, static_cast<TextPosition>(mapped_str.str.length()) - 1);
-    if (index > 0)
-      return mapped_str.to_original_index(index);
-    prev_start = start;
+    auto begin = prev_token_begin(window.str(), index);
+    if (begin > 0)
+      return window.to_original_index(begin);
+    if (!window.extend_left(shift))
+      return window.begin();
     shift *= 2;
   }
-  return start;
 }
 
 TextPosition SpellChecker::next_token_end_in_document(TextPosition end) const {
+  DocumentTextWindow window(m_editor, end);
+  return next_token_end_in_document(window, end);
+}
+
+TextPosition SpellChecker::next_token_end_in_document(DocumentTextWindow &window, TextPosition end) const {
+  window.extend_to(end);
+
   TextPosition shift = 15;
-  auto prev_end = end;
-  auto length = m_editor.get_active_document_length();
-  if (end == length)
-    return end;
-  while (end > 0) {
-    end = std::min(end + shift, length);
-    auto mapped_str = m_editor.get_mapped_wstring_range(prev_end, end);
-    // finding any start before start which starts a token
-    auto index = next_token_end(mapped_str.str, 0);
-    if (index < static_cast<TextPosition>(mapped_str.str.length()))
-      return mapped_str.to_original_index(index);
-    if (end == length)
-      return end;
-    prev_end = end;
+  while (true) {
+    auto index = next_token_end(window.str(), window.from_original_index(end));
+    if (index < window.length())
+      return window.to_original_index(index);
+    if (!window.extend_right(shift))
+      return window.end();
     shift *= 2;
   }
-  return end;
 }
 
-void SpellChecker::underline_misspelled_words_in_visible_text() {
-  const int optimal_range_len = 4096;
-
+std::array<TextPosition, 2> SpellChecker::get_visible_line_range() const {
   const auto top_visible_line = m_editor.get_first_visible_line();
   const auto top_visible_line_index = m_editor.get_document_line_from_visible(top_visible_line);
   const auto bottom_visible_line_index = m_editor.get_document_line_from_visible(top_visible_line + m_editor.get_lines_on_screen() - 1);
+  return {top_visible_line_index, bottom_visible_line_index};
+}
+
+void SpellChecker::underline_misspelled_words_in_visible_text() {
+  auto [first_line, last_line] = get_visible_line_range();
+  std::vector<MappedWstring> texts;
+  collect_visible_texts(first_line, last_line, texts);
+  underline_misspelled_words(std::move(texts), true);
+}
+
+void SpellChecker::underline_misspelled_words_in_lines(TextPosition first_line, TextPosition last_line) {
+  // lines could be very long (e.g. minified files), such are left to be checked when they become visible
+  constexpr TextPosition max_length = 64 * 1024;
+  last_line = std::min(last_line, m_editor.get_document_line_count() - 1);
+  if (first_line > last_line)
+    return;
+
+  const auto begin = m_editor.get_line_start_position(first_line);
+  const auto end = m_editor.get_line_end_position(last_line);
+  if (begin >= end || end - begin > max_length)
+    return;
+
+  // lines outside of the screen are not necessarily styled yet
+  m_editor.force_style_update(begin, end);
+  underline_misspelled_words(m_editor.get_mapped_wstring_range(begin, end), begin);
+}
+
+void SpellChecker::collect_visible_texts(TextPosition first_line, TextPosition last_line, std::vector<MappedWstring> &texts) {
+  const int optimal_range_len = 4096;
+
   const auto rect = m_editor.editor_rect();
   const auto len = m_editor.get_active_document_length();
 
   const auto first_visible_column = m_editor.get_first_visible_column();
   
-  for (auto line = top_visible_line_index; line <= bottom_visible_line_index; ++line) {
+  for (auto line = first_line; line <= last_line; ++line) {
     if (!m_editor.is_line_visible(line))
       continue;
     auto start = m_editor.get_line_start_position(line);
@@ -247,37 +375,40 @@ void SpellChecker::underline_misspelled_words_in_visible_text() {
       continue;
 
     for (auto end = start + optimal_range_len; start < line_end; start = end + 1, end = start + optimal_range_len) {
+      DocumentTextWindow window(m_editor, start);
       const auto start_point = m_editor.get_point_from_position(start);
       if (start_point.y < rect.top) {
         start = m_editor.char_position_from_point({0, 0});
-        start = prev_token_begin_in_document(start);
+        start = prev_token_begin_in_document(window, start);
       } else if (start_point.x < rect.left) {
         start = m_editor.char_position_from_point({0, start_point.y});
-        start = prev_token_begin_in_document(start);
+        start = prev_token_begin_in_document(window, start);
       } else if (first_visible_column > 0) {
-        start = prev_token_begin_in_document(start);
+        start = prev_token_begin_in_document(window, start);
       }
   
       if (end > line_end) {
         end = line_end;
       }
+      // range text is decoded once, searches for token boundaries only extend it
+      window.extend_to(end);
   
       const auto end_point = m_editor.get_point_from_position(end);
       if (end_point.y > rect.bottom - rect.top) {
         end = m_editor.char_position_from_point({rect.right - rect.left, rect.bottom - rect.top});
-        end = next_token_end_in_document(end);
+        end = next_token_end_in_document(window, end);
       } else if (end_point.x > rect.right) {
         end = m_editor.char_position_from_point({rect.right - rect.left, end_point.y});
-        end = next_token_end_in_document(end);
+        end = next_token_end_in_document(window, end);
       }
 
       // Stop if the start of this range is not visible
       if (start > end)
         break;
   
-      const auto new_str = m_editor.get_mapped_wstring_range(start, end);
-  
-      underline_misspelled_words(new_str, start);
+      auto new_str = window.text(start, end);
+      if (!new_str.str.empty())
+        texts.push_back(std::move(new_str));
     }
   }
 }
@@ -297,6 +428,13 @@ bool SpellChecker::is_spellchecking_needed(std::wstring_view word, TextPosition
   return SpellCheckerHelpers::is_word_spell_checking_needed(m_settings, m_editor, word, word_start);
 }
 
+bool SpellChecker::is_spellchecking_needed(std::wstring_view word, const EditorStyleSnapshot &style_snapshot, TextPosition word_start) const {
+  if (!m_speller_container.active_speller().is_working())
+    return false;
+
+  return SpellCheckerHelpers::is_word_spell_checking_needed(m_settings, style_snapshot, word, word_start);
+}
+
 bool SpellChecker::is_word_under_cursor_correct(TextPosition &pos, TextPosition &length, bool use_text_cursor) const {
   TextPosition init_char_pos, selection_start = 0, selection_end = 0;
   ACTIVE_VIEW_BLOCK(m_editor);
@@ -322,10 +460,11 @@ bool SpellChecker::is_word_under_cursor_correct(TextPosition &pos, TextPosition
     init_char_pos = std::min(selection_start, selection_end);
   }
 
-  const auto start = prev_token_begin_in_document(init_char_pos);
-  const auto end = next_token_end_in_document(start + 1);
+  DocumentTextWindow window(m_editor, init_char_pos);
+  const auto start = prev_token_begin_in_document(window, init_char_pos);
+  const auto end = next_token_end_in_document(window, start + 1);
   
-  const auto mapped_str = m_editor.get_mapped_wstring_range(start, end);
+  const auto mapped_str = window.text(start, end);
   if (mapped_str.str.empty())
     return true;
   auto word = get_word_at(init_char_pos, mapped_str);
@@ -346,17 +485,19 @@ bool SpellChecker::is_word_under_cursor_correct(TextPosition &pos, TextPosition
 
 void SpellChecker::erase_all_misspellings() {
   ACTIVE_VIEW_BLOCK(m_editor);
-  auto mapped_str = m_editor.to_mapped_wstring(m_editor.get_active_document_text());
-  auto misspelled_words = get_misspelled_words(mapped_str);
+  auto buf = m_editor.get_active_document_text();
+  auto mapped_str = m_editor.to_mapped_wstring(buf);
+  std::vector<SpellCheckerHelpers::TextReplacement> replacements;
+  for_each_checked_word(mapped_str, [&](const SpellerWordData &word) {
+    if (!word.is_correct)
+      replacements.push_back({word.word_start, word.word_end, {}});
+    return true;
+  });
+  if (replacements.empty())
+    return;
 
   UNDO_BLOCK(m_editor);
-  TextPosition chars_removed = 0;
-  for (auto &misspelling : misspelled_words) {
-    auto start = mapped_str.to_original_index(misspelling.data() - mapped_str.str.data());
-    auto original_len = mapped_str.to_original_index(static_cast<TextPosition>(misspelling.data() - mapped_str.str.data() + misspelling.length())) - start;
-    m_editor.delete_range(start - chars_removed, original_len);
-    chars_removed += original_len;
-  }
+  SpellCheckerHelpers::replace_ranges(m_editor, buf, replacements);
 }
 
 bool SpellChecker::check_word(std::wstring_view word, TextPosition word_start) const {
@@ -365,7 +506,16 @@ bool SpellChecker::check_word(std::wstring_view word, TextPosition word_start) c
   if (!is_spellchecking_needed(word, word_start))
     return true;
 
-  return m_speller_container.active_speller().check_word(to_word_for_speller(word));
+  auto word_for_speller = to_word_for_speller(word);
+  if (auto verdict = m_verdict_cache.find(word_for_speller))
+    return *verdict;
+
+  auto is_correct = [&] {
+    auto lock = lock_spellers();
+    return m_speller_container.active_speller().check_word(word_for_speller);
+  }();
+  m_verdict_cache.insert(word_for_speller, is_correct);
+  return is_correct;
 }
 
 TextPosition SpellChecker::next_token_end(std::wstring_view target, TextPosition index) const {
@@ -376,107 +526,296 @@ TextPosition SpellChecker::prev_token_begin(std::wstring_view target, TextPositi
   return m_settings.do_with_tokenizer(target, [index](const auto &tokenizer) { return tokenizer.prev_token_begin(index); });
 }
 
-class SpellerWordData {
-public:
-  std::wstring_view token;
-  WordForSpeller word_for_speller;
-  TextPosition word_start;
-  TextPosition word_end;
-  bool is_correct;
+struct SpellChecker::PreparedCheck {
+  void add(SpellerWordData word, const WordVerdictCache &verdict_cache) {
+    if (auto verdict = verdict_cache.find(word.word_for_speller))
+      word.is_correct = *verdict;
+    else {
+      uncached_indices.push_back(words.size());
+      words_for_speller.push_back(std::move(word.word_for_speller));
+    }
+    words.push_back(std::move(word));
+  }
+
+  void clear() {
+    words.clear();
+    uncached_indices.clear();
+    words_for_speller.clear();
+  }
+
+  std::vector<SpellerWordData> words;
+  std::vector<size_t> uncached_indices;
+  std::vector<WordForSpeller> words_for_speller; // verdicts for these are needed from speller
 };
 
-std::vector<SpellerWordData> SpellChecker::check_text(const MappedWstring &text_to_check) const {
+template <typename FunctionType> void SpellChecker::for_each_word_to_check(const MappedWstring &text_to_check, const FunctionType &function) const {
   if (text_to_check.str.empty())
-    return {};
-  auto sv = std::wstring_view(text_to_check.str);
-  std::vector<std::wstring_view> tokens;
-  m_settings.do_with_tokenizer(sv, [&](const auto &tokenizer) { tokens = tokenizer.get_all_tokens(); });
-
-  std::vector<bool> results(tokens.size());
-  std::vector<SpellerWordData> words_to_check;
-  words_to_check.clear();
-  std::vector<WordForSpeller> words_for_speller;
-  for (auto token : tokens) {
-    SpellCheckerHelpers::cut_apostrophes(m_settings, token);
-    auto word_start = text_to_check.to_original_index(token.data() - text_to_check.str.data());
-    auto word_end = text_to_check.to_original_index(
-        static_cast<TextPosition>(token.data() - text_to_check.str.data() + token.length()));
-    if (is_spellchecking_needed(token, word_start)) {
-      words_to_check.emplace_back();
-      auto &w = words_to_check.back();
-      w.word_for_speller = to_word_for_speller(token);
-      w.word_start = word_start;
-      w.word_end = word_end;
-      w.token = token;
+    return;
+  auto style_snapshot = m_editor.get_style_snapshot(text_to_check.to_original_index(0), text_to_check.original_length());
+  m_settings.do_with_tokenizer(text_to_check.str, [&](const auto &tokenizer) {
+    for (auto token : tokenizer.tokens()) {
+      SpellCheckerHelpers::cut_apostrophes(m_settings, token);
+      auto word_start = text_to_check.to_original_index(token.data() - text_to_check.str.data());
+      auto word_end = text_to_check.to_original_index(
+          static_cast<TextPosition>(token.data() - text_to_check.str.data() + token.length()));
+      if (!is_spellchecking_needed(token, style_snapshot, word_start))
+        continue;
+      if (!function(SpellerWordData{token, to_word_for_speller(token), word_start, word_end, false}))
+        return;
+    }
+  });
+}
+
+template <typename FunctionType>
+void SpellChecker::for_each_utf8_word_to_check(std::string_view text, TextPosition text_begin, const FunctionType &function) const {
+  if (text.empty())
+    return;
+  auto style_snapshot = m_editor.get_style_snapshot(text_begin, text_begin + static_cast<TextPosition>(text.length()));
+  m_settings.do_with_utf8_tokenizer(text, [&](const auto &tokenizer) {
+    std::wstring decoded;
+    for (auto token : tokenizer.tokens()) {
+      // only words themselves are decoded since filtering and conversions work with wide strings
+      decoded = utf8_decode_bmp(token);
+      std::wstring_view word = decoded;
+      SpellCheckerHelpers::cut_apostrophes(m_settings, word);
+      if (word.length() != decoded.length()) {
+        const auto prefix_length = static_cast<size_t>(word.data() - decoded.data());
+        token.remove_prefix(utf8_encode(std::wstring_view(decoded).substr(0, prefix_length)).length());
+        token.remove_suffix(utf8_encode(std::wstring_view(decoded).substr(prefix_length + word.length())).length());
+      }
+      const auto word_start = text_begin + static_cast<TextPosition>(token.data() - text.data());
+      const auto word_end = word_start + static_cast<TextPosition>(token.length());
+      if (!is_spellchecking_needed(word, style_snapshot, word_start))
+        continue;
+      const auto next_char_index = static_cast<size_t>(word_end - text_begin);
+      const bool ends_with_dot = next_char_index < text.length() && text[next_char_index] == '.';
+      if (!function(SpellerWordData{{}, to_word_for_speller(word, ends_with_dot, token), word_start, word_end, false}))
+        return;
     }
+  });
+}
+
+SpellChecker::PreparedCheck SpellChecker::prepare_check(const MappedWstring &text_to_check) const {
+  PreparedCheck check;
+  for_each_word_to_check(text_to_check, [&](SpellerWordData word) {
+    check.add(std::move(word), m_verdict_cache);
+    return true;
+  });
+  return check;
+}
+
+size_t SpellChecker::complete_check(PreparedCheck &check, const std::vector<bool> &results, size_t offset) const {
+  for (size_t i = 0; i < check.uncached_indices.size(); ++i) {
+    // empty result means that all words are correct
+    bool is_correct = results.empty() || results[offset + i];
+    check.words[check.uncached_indices[i]].is_correct = is_correct;
+    m_verdict_cache.insert(check.words_for_speller[i], is_correct);
   }
-  words_for_speller.resize(words_to_check.size());
-  std::transform(words_to_check.begin(), words_to_check.end(),
-                 words_for_speller.begin(), [](auto &word) -> auto&& { return std::move(word.word_for_speller); });
-  auto spellcheck_result = m_speller_container.active_speller().check_words(words_for_speller);
-  if (!spellcheck_result.empty()) {
-    for (int i = 0; i < static_cast<int>(words_for_speller.size()); ++i)
-      words_to_check[i].is_correct = spellcheck_result[i];
-  } else
-    for (auto &w : words_to_check)
-      w.is_correct = true;
-  return words_to_check;
+  return check.uncached_indices.size();
+}
+
+template <typename WordSourceType>
+void SpellChecker::check_by_batches(const WordSourceType &for_each_word, const std::function<bool(const SpellerWordData &)> &function) const {
+  PreparedCheck batch;
+  bool stopped = false;
+  auto flush = [&] {
+    if (!batch.words_for_speller.empty()) {
+      auto lock = lock_spellers();
+      complete_check(batch, m_speller_container.active_speller().check_words(batch.words_for_speller), 0);
+    }
+    for (auto &word : batch.words) {
+      if (!function(word)) {
+        stopped = true;
+        break;
+      }
+    }
+    batch.clear();
+    return !stopped;
+  };
+  for_each_word([&](SpellerWordData word) {
+    batch.add(std::move(word), m_verdict_cache);
+    return batch.words.size() < speller_batch_size || flush();
+  });
+  if (!stopped)
+    flush();
+}
+
+void SpellChecker::for_each_checked_word(const MappedWstring &text_to_check, const std::function<bool(const SpellerWordData &)> &function) const {
+  check_by_batches([&](const auto &on_word) { for_each_word_to_check(text_to_check, on_word); }, function);
+}
+
+void SpellChecker::for_each_checked_utf8_word(std::string_view text, TextPosition text_begin,
+                                              const std::function<bool(const SpellerWordData &)> &function) const {
+  check_by_batches([&](const auto &on_word) { for_each_utf8_word_to_check(text, text_begin, on_word); }, function);
+}
+
+bool SpellChecker::is_utf8_checking_possible() const {
+  return m_editor.get_encoding() == EditorCodepage::utf8 && m_speller_container.active_speller().accepts_utf8_words();
 }
 
 void SpellChecker::underline_misspelled_words(const MappedWstring &text_to_check, const TextPosition start_pos) const {
-  std::vector<TextPosition> underline_buffer;
-  auto words_to_check = check_text(text_to_check);
-  for (auto &result : words_to_check) {
-    if (result.is_correct)
-      continue;
-    std::array list{result.word_start, result.word_end};
-    underline_buffer.insert(underline_buffer.end(), list.begin(), list.end());
+  std::vector<TextRange> underlined;
+  for_each_checked_word(text_to_check, [&](const SpellerWordData &word) {
+    if (!word.is_correct)
+      underlined.push_back({word.word_start, word.word_end});
+    return true;
+  });
+
+  update_underlines(start_pos, text_to_check.original_length(), underlined);
+}
+
+struct SpellChecker::AsyncCheck {
+  HWND view_hwnd = nullptr;
+  std::wstring path;
+  uint64_t generation = 0;
+  std::vector<MappedWstring> texts; // prepared checks refer to these
+  std::vector<PreparedCheck> checks;
+};
+
+void SpellChecker::underline_misspelled_words(std::vector<MappedWstring> texts, bool covers_visible_area) {
+  if (texts.empty())
+    return;
+
+  if (!is_async_checking_possible()) {
+    for (auto &text : texts)
+      underline_misspelled_words(text, text.to_original_index(0));
+    return;
   }
 
-  TextPosition prev_pos = start_pos;
-  for (TextPosition i = 0; i < static_cast<TextPosition>(underline_buffer.size()) - 1; i += 2) {
-    remove_underline(prev_pos, underline_buffer[i]); // remove from end of last to start of new
-    create_word_underline(underline_buffer[i], underline_buffer[i + 1]);
-    prev_pos = underline_buffer[i + 1]; // update end of last
+  // newer check replaces pending one, so ranges of pending one are covered only by checking the whole visible area
+  auto view_hwnd = m_editor.get_view_hwnd();
+  if (!covers_visible_area && m_async_check_pending[view_hwnd])
+    return recheck_visible();
+
+  auto check = std::make_shared<AsyncCheck>();
+  check->view_hwnd = view_hwnd;
+  check->path = m_editor.active_document_path();
+  check->generation = document_generation(check->path);
+  check->texts = std::move(texts);
+  std::vector<WordForSpeller> words_for_speller;
+  for (auto &text : check->texts) {
+    check->checks.push_back(prepare_check(text));
+    auto &words = check->checks.back().words_for_speller;
+    words_for_speller.insert(words_for_speller.end(), words.begin(), words.end());
   }
 
-  auto text_len = text_to_check.original_length();
-  remove_underline(prev_pos, text_len); // remove from end of last word to end of text
+  if (words_for_speller.empty()) {
+    cancel_async_check();
+    return apply_async_check(*check, {});
+  }
+
+  m_async_check_pending[view_hwnd] = true;
+  auto apply = [this, check](std::vector<bool> results) { apply_async_check(*check, results); };
+  check_words_deferred(m_async_checks.try_emplace(view_hwnd, m_async_target_hwnd).first->second, std::move(words_for_speller), std::move(apply));
+}
+
+void SpellChecker::check_words_deferred(TaskWrapper &task, std::vector<WordForSpeller> words_for_speller,
+                                        std::function<void(std::vector<bool>)> apply) const {
+  // shared_ptr since TaskWrapper uses std::function
+  auto query = [words = std::make_shared<std::vector<WordForSpeller>>(std::move(words_for_speller)),
+                &speller = m_speller_container.active_speller()](concurrency::cancellation_token token) {
+    std::vector<bool> results;
+    results.reserve(words->size());
+    for (size_t begin = 0; begin < words->size(); begin += speller_batch_size) {
+      // lock is taken per batch so UI thread never waits for the whole check
+      auto lock = lock_spellers();
+      if (token.is_canceled())
+        return std::vector<bool>{};
+      std::vector<WordForSpeller> batch(words->begin() + begin, words->begin() + std::min(begin + speller_batch_size, words->size()));
+      auto batch_results = speller.check_words(batch);
+      if (batch_results.empty())
+        batch_results.assign(batch.size(), true);
+      results.insert(results.end(), batch_results.begin(), batch_results.end());
+    }
+    return results;
+  };
+  if (m_async_check_runner)
+    return m_async_check_runner([query] { return query(concurrency::cancellation_token::none()); }, std::move(apply));
+
+  task.do_deferred(std::move(query), std::move(apply));
+}
+
+void SpellChecker::apply_async_check(AsyncCheck &check, const std::vector<bool> &results) {
+  m_async_check_pending[check.view_hwnd] = false;
+  auto view_count = m_editor.get_view_count();
+  for (int view_index = 0; view_index < view_count; ++view_index) {
+    TARGET_VIEW_BLOCK(m_editor, view_index);
+    if (m_editor.get_view_hwnd() != check.view_hwnd)
+      continue;
+
+    // another document is shown in the view now, it is checked separately
+    if (m_editor.active_document_path() != check.path)
+      return;
+    // document or verdicts changed in the meantime so results could be wrong
+    if (document_generation(check.path) != check.generation)
+      return recheck_visible();
+
+    size_t offset = 0;
+    for (size_t i = 0; i < check.checks.size(); ++i) {
+      offset += complete_check(check.checks[i], results, offset);
+      std::vector<TextRange> underlined;
+      for (auto &result : check.checks[i].words) {
+        if (!result.is_correct)
+          underlined.push_back({result.word_start, result.word_end});
+      }
+      update_underlines(check.texts[i].to_original_index(0), check.texts[i].original_length(), underlined);
+    }
+    return;
+  }
+}
+
+bool SpellChecker::is_async_checking_possible() const {
+  // native speller is COM-based and bound to UI thread apartment
+  return (m_async_target_hwnd != nullptr || m_async_check_runner) && m_settings.data.active_speller_lib_id != SpellerId::native;
+}
+
+void SpellChecker::enable_async_checking(HWND target_hwnd) {
+  m_async_target_hwnd = target_hwnd;
+}
+
+void SpellChecker::enable_async_checking(AsyncCheckRunner runner) {
+  m_async_check_runner = std::move(runner);
+}
+
+void SpellChecker::cancel_async_checks() {
+  m_async_checks.clear();
+  m_async_check_pending.clear();
+  m_async_index_check.reset();
+  m_async_index_check_pending = false;
+}
+
+void SpellChecker::cancel_async_check() {
+  auto view_hwnd = m_editor.get_view_hwnd();
+  m_async_checks.erase(view_hwnd);
+  m_async_check_pending.erase(view_hwnd);
 }
 
-std::vector<std::wstring_view> SpellChecker::get_misspelled_words(const MappedWstring &text_to_check) const {
-  auto words_to_check = check_text(text_to_check);
-  std::vector<std::wstring_view> misspelled_words;
-  using namespace std::ranges;
-  copy(words_to_check |
-       views::filter(std::not_fn(&SpellerWordData::is_correct)) |
-       views::transform(&SpellerWordData::token),
-       std::back_inserter(misspelled_words));
-  return misspelled_words;
+uint64_t SpellChecker::document_generation(const std::wstring &path) const {
+  auto it = m_document_generations.find(path);
+  return m_common_generation + (it != m_document_generations.end() ? it->second : 0);
 }
 
 std::optional<std::array<TextPosition, 2>> SpellChecker::find_first_misspelling(const MappedWstring &text_to_check, TextPosition last_valid_position) const {
-  auto words_to_check = check_text(text_to_check);
-  auto it = std::ranges::find_if(words_to_check, [last_valid_position](const SpellerWordData &data) {
-    return !data.is_correct && data.word_end > last_valid_position;
+  std::optional<std::array<TextPosition, 2>> result;
+  for_each_checked_word(text_to_check, [&](const SpellerWordData &word) {
+    if (word.is_correct || word.word_end <= last_valid_position)
+      return true;
+    result = std::array{word.word_start, word.word_end};
+    return false;
   });
-  if (it == words_to_check.end())
-    return {};
-
-  return std::array{it->word_start, it->word_end};
+  return result;
 }
 
 std::optional<std::array<TextPosition, 2>> SpellChecker::find_last_misspelling(const MappedWstring &text_to_check, TextPosition last_valid_position) const {
-  auto words_to_check = check_text(text_to_check);
-  using namespace std::ranges;
-  auto reversed = views::reverse(words_to_check);
-  auto it = find_if(reversed, [last_valid_position](const SpellerWordData &word_data) {
-    return !word_data.is_correct && word_data.word_end < last_valid_position;
+  std::optional<std::array<TextPosition, 2>> result;
+  for_each_checked_word(text_to_check, [&](const SpellerWordData &word) {
+    if (word.word_end >= last_valid_position)
+      return false;
+    if (!word.is_correct)
+      result = std::array{word.word_start, word.word_end};
+    return true;
   });
-  if (it == reversed.end())
-    return {};
-
-  return std::array{it->word_start, it->word_end};
+  return result;
 }
 
 void SpellChecker::check_visible() {
@@ -485,51 +824,368 @@ void SpellChecker::check_visible() {
   underline_misspelled_words_in_visible_text();
 }
 
-void SpellChecker::recheck_visible() {
-  if (!m_speller_container.active_speller().is_working()) {
+bool SpellChecker::prepare_visible_recheck() {
+  m_dirty_ranges.erase(m_editor.active_document_path());
+  if (!m_speller_container.active_speller().is_working() ||
+      !SpellCheckerHelpers::is_spell_checking_needed_for_file(m_editor, m_settings)) {
+    cancel_prefetch();
+    cancel_async_check();
     clear_all_underlines();
-    return;
+    return false;
   }
+  return true;
+}
 
-  if (!SpellCheckerHelpers::is_spell_checking_needed_for_file(m_editor, m_settings))
-    return clear_all_underlines();
+void SpellChecker::recheck_visible() {
+  if (!prepare_visible_recheck())
+    return;
 
   check_visible();
+  schedule_prefetch();
 }
 
-std::wstring SpellChecker::get_all_misspellings_as_string() const {
+void SpellChecker::schedule_prefetch() {
+  schedule_prefetch({get_visible_line_range()});
+}
+
+void SpellChecker::schedule_prefetch(const std::vector<std::array<TextPosition, 2>> &visible_line_ranges) {
+  auto &line_ranges = m_prefetch_line_ranges[m_editor.active_document_path()];
+  line_ranges.clear();
+  const auto screen_count = m_settings.data.prefetch_screen_count;
+  if (screen_count > 0) {
+    const auto lines_on_screen = std::max(m_editor.get_lines_on_screen(), TextPosition{1});
+    const auto last_document_line = m_editor.get_document_line_count() - 1;
+    // one screen at a time, closest to visible area go first
+    std::vector<std::vector<std::array<TextPosition, 2>>> screens_around;
+    for (auto [first_visible_line, last_visible_line] : visible_line_ranges) {
+      auto &screens = screens_around.emplace_back();
+      const auto last_line = std::min(last_visible_line + screen_count * lines_on_screen, last_document_line);
+      const auto first_line = std::max(first_visible_line - screen_count * lines_on_screen, TextPosition{0});
+      auto below = last_visible_line + 1;
+      auto above = first_visible_line - 1;
+      while (below <= last_line || above >= first_line) {
+        if (below <= last_line)
+          screens.push_back({below, std::min(below + lines_on_screen - 1, last_line)});
+        if (above >= first_line)
+          screens.push_back({std::max(above - lines_on_screen + 1, first_line), above});
+        below += lines_on_screen;
+        above -= lines_on_screen;
+      }
+    }
+    // screens around different views alternate, lines which are visible or already scheduled are skipped
+    IntervalSet<TextPosition> covered_lines;
+    for (auto [first_visible_line, last_visible_line] : visible_line_ranges)
+      covered_lines.add(first_visible_line, last_visible_line + 1);
+    for (size_t index = 0; std::ranges::any_of(screens_around, [index](const auto &screens) { return index < screens.size(); }); ++index) {
+      for (auto &screens : screens_around) {
+        if (index >= screens.size())
+          continue;
+        IntervalSet<TextPosition> lines;
+        lines.add(screens[index][0], screens[index][1] + 1);
+        for (auto &interval : covered_lines.intervals())
+          lines.remove(interval.begin, interval.end);
+        for (auto &interval : lines.intervals())
+          line_ranges.push_back({interval.begin, interval.end - 1});
+        covered_lines.add(screens[index][0], screens[index][1] + 1);
+      }
+    }
+    std::reverse(line_ranges.begin(), line_ranges.end());
+  }
+  if (line_ranges.empty()) {
+    m_prefetch_line_ranges.erase(m_editor.active_document_path());
+    return;
+  }
+  prefetch_scheduled();
+}
+
+void SpellChecker::cancel_prefetch() {
+  m_prefetch_line_ranges.erase(m_editor.active_document_path());
+}
+
+bool SpellChecker::prefetch_next_chunk() {
+  auto it = m_prefetch_line_ranges.find(m_editor.active_document_path());
+  if (it == m_prefetch_line_ranges.end())
+    return false;
+
+  auto [first_line, last_line] = it->second.back();
+  it->second.pop_back();
+  if (it->second.empty())
+    m_prefetch_line_ranges.erase(it);
+  underline_misspelled_words_in_lines(first_line, last_line);
+  return m_prefetch_line_ranges.contains(m_editor.active_document_path());
+}
+
+void SpellChecker::on_text_inserted(TextPosition pos, TextPosition length) {
+  auto path = m_editor.active_document_path();
+  ++m_document_generations[path];
+  auto &ranges = m_dirty_ranges[path];
+  ranges.on_insert(pos, length);
+  ranges.add(pos, pos + length);
+  if (auto it = m_misspelling_indices.find(path); it != m_misspelling_indices.end()) {
+    it->second.on_insert(pos, length);
+    invalidate_misspelling_index_lines(it->second, pos, pos + length);
+    misspelling_index_outdated();
+  }
+}
+
+void SpellChecker::on_text_deleted(TextPosition pos, TextPosition length) {
+  auto path = m_editor.active_document_path();
+  ++m_document_generations[path];
+  auto &ranges = m_dirty_ranges[path];
+  ranges.on_delete(pos, length);
+  // words around deletion point are merged now so they need recheck as well
+  ranges.add(pos, pos + 1);
+  if (auto it = m_misspelling_indices.find(path); it != m_misspelling_indices.end()) {
+    it->second.on_delete(pos, length);
+    invalidate_misspelling_index_lines(it->second, pos, pos);
+    misspelling_index_outdated();
+  }
+}
+
+void SpellChecker::on_other_window_modified(HWND window) {
+  {
+    ACTIVE_VIEW_BLOCK(m_editor);
+    if (m_editor.shows_same_document(window))
+      return;
+  }
+  std::vector<std::wstring> shown_paths;
+  auto view_count = m_editor.get_view_count();
+  for (int view_index = 0; view_index < view_count; ++view_index) {
+    TARGET_VIEW_BLOCK(m_editor, view_index);
+    if (m_editor.shows_same_document(window))
+      return invalidate_document(m_editor.active_document_path());
+    shown_paths.push_back(m_editor.active_document_path());
+  }
+
+  // there's no way to know which of the documents not shown was modified
+  std::vector<std::wstring> hidden_paths;
+  for (auto &[path, index] : m_misspelling_indices)
+    if (std::ranges::find(shown_paths, path) == shown_paths.end())
+      hidden_paths.push_back(path);
+  for (auto &path : hidden_paths)
+    invalidate_document(path);
+}
+
+void SpellChecker::invalidate_document(const std::wstring &path) {
+  ++m_document_generations[path];
+  m_dirty_ranges.erase(path);
+  m_prefetch_line_ranges.erase(path);
+  m_misspelling_indices.erase(path);
+}
+
+void SpellChecker::on_document_closed(const std::wstring &path) {
+  m_dirty_ranges.erase(path);
+  m_misspelling_indices.erase(path);
+  m_prefetch_line_ranges.erase(path);
+  m_document_generations.erase(path);
+  // generations of reopened document start anew, so pending checks of the closed one could match them
+  ++m_common_generation;
+}
+
+void SpellChecker::invalidate_misspelling_index_lines(MisspellingIndex &index, TextPosition from, TextPosition to) const {
+  auto begin = m_editor.get_line_start_position(m_editor.line_from_position(from));
+  auto last_line = m_editor.line_from_position(to);
+  auto end = last_line + 1 < m_editor.get_document_line_count() ? m_editor.get_line_start_position(last_line + 1)
+                                                                 : m_editor.get_active_document_length();
+  index.invalidate(begin, std::max(end, begin + 1));
+}
+
+void SpellChecker::clear_misspelling_indices() {
+  m_misspelling_indices.clear();
+  misspelling_index_outdated();
+}
+
+TextPosition SpellChecker::get_check_chunk_end(TextPosition begin) const {
+  // chunks are aligned to lines unless line is too long
+  const auto doc_length = m_editor.get_active_document_length();
+  auto last_line = m_editor.line_from_position(std::min(begin + check_chunk_size, doc_length));
+  auto end = last_line + 1 < m_editor.get_document_line_count() ? m_editor.get_line_start_position(last_line + 1) : doc_length;
+  if (end - begin > 2 * check_chunk_size) {
+    end = prev_token_begin_in_document(begin + check_chunk_size);
+    if (end <= begin)
+      end = next_token_end_in_document(begin + check_chunk_size);
+  }
+  return end;
+}
+
+void SpellChecker::for_each_misspelling_in_active_document(const std::function<void(std::wstring_view word, TextPosition word_start)> &function) const {
+  const auto doc_length = m_editor.get_active_document_length();
+  const bool use_utf8 = is_utf8_checking_possible();
+  for (TextPosition begin = 0; begin < doc_length;) {
+    auto end = get_check_chunk_end(begin);
+    m_editor.force_style_update(begin, end);
+    if (use_utf8) {
+      auto text = m_editor.get_text_range(begin, end);
+      for_each_checked_utf8_word(text, begin, [&](const SpellerWordData &word) {
+        if (!word.is_correct)
+          function(utf8_decode_bmp(std::string_view(text).substr(word.word_start - begin, word.word_end - word.word_start)), word.word_start);
+        return true;
+      });
+    } else {
+      for_each_checked_word(m_editor.get_mapped_wstring_range(begin, end), [&](const SpellerWordData &word) {
+        if (!word.is_correct)
+          function(word.token, word.word_start);
+        return true;
+      });
+    }
+    begin = end;
+  }
+}
+
+bool SpellChecker::update_misspelling_index() {
+  if (!m_speller_container.active_speller().is_working() ||
+      !SpellCheckerHelpers::is_spell_checking_needed_for_file(m_editor, m_settings))
+    return false;
+
+  auto &index = m_misspelling_indices[m_editor.active_document_path()];
+  const auto doc_length = m_editor.get_active_document_length();
+  auto mb_begin = index.first_unchecked_position(doc_length);
+  if (!mb_begin)
+    return false;
+
+  auto begin = m_editor.get_line_start_position(m_editor.line_from_position(*mb_begin));
+  auto end = get_check_chunk_end(begin);
+  m_editor.force_style_update(begin, end);
+  if (is_async_checking_possible()) {
+    // only one chunk is checked at a time, misspelling_index_outdated is fired once its results are applied
+    if (m_async_index_check_pending)
+      return false;
+
+    auto check = std::make_shared<AsyncCheck>();
+    check->path = m_editor.active_document_path();
+    check->generation = document_generation(check->path);
+    check->texts.push_back(m_editor.get_mapped_wstring_range(begin, end));
+    check->checks.push_back(prepare_check(check->texts.back()));
+    auto words_for_speller = check->checks.back().words_for_speller;
+    if (words_for_speller.empty()) {
+      apply_async_index_check(*check, {});
+      return !index.is_complete(doc_length);
+    }
+
+    m_async_index_check_pending = true;
+    if (!m_async_index_check)
+      m_async_index_check.emplace(m_async_target_hwnd);
+    auto apply = [this, check](std::vector<bool> results) {
+      m_async_index_check_pending = false;
+      apply_async_index_check(*check, results);
+      misspelling_index_outdated();
+    };
+    check_words_deferred(*m_async_index_check, std::move(words_for_speller), std::move(apply));
+    return false;
+  }
+
+  std::vector<MisspellingIndex::Range> misspellings;
+  auto add_misspelling = [&](const SpellerWordData &word) {
+    if (!word.is_correct)
+      misspellings.push_back({word.word_start, word.word_end});
+    return true;
+  };
+  if (is_utf8_checking_possible())
+    for_each_checked_utf8_word(m_editor.get_text_range(begin, end), begin, add_misspelling);
+  else
+    for_each_checked_word(m_editor.get_mapped_wstring_range(begin, end), add_misspelling);
+  index.set_checked(begin, end, misspellings);
+  return !index.is_complete(doc_length);
+}
+
+void SpellChecker::apply_async_index_check(AsyncCheck &check, const std::vector<bool> &results) {
+  auto it = m_misspelling_indices.find(check.path);
+  // document was modified or closed in the meantime, the chunk is checked again
+  if (it == m_misspelling_indices.end() || document_generation(check.path) != check.generation)
+    return;
+
+  complete_check(check.checks.front(), results, 0);
+  std::vector<MisspellingIndex::Range> misspellings;
+  for (auto &word : check.checks.front().words) {
+    if (!word.is_correct)
+      misspellings.push_back({word.word_start, word.word_end});
+  }
+  it->second.set_checked(check.texts.front().to_original_index(0), check.texts.front().original_length(), misspellings);
+}
+
+bool SpellChecker::is_misspelling_index_complete() const {
   ACTIVE_VIEW_BLOCK(m_editor);
-  auto buf = m_editor.get_active_document_text();
-  auto mapped_str = m_editor.to_mapped_wstring(buf);
-  m_editor.force_style_update(mapped_str.mapping.front(), mapped_str.mapping.back());
-  auto misspelled_words = get_misspelled_words(mapped_str);
-  std::sort(misspelled_words.begin(), misspelled_words.end(), [](const auto &lhs, const auto &rhs) {
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](wchar_t lhs, wchar_t rhs) {
-      return CharUpper(reinterpret_cast<LPWSTR>(lhs)) < CharUpper(reinterpret_cast<LPWSTR>(rhs));
-    });
-  });
-  auto it = std::unique(misspelled_words.begin(), misspelled_words.end(), [](const auto &lhs, const auto &rhs) {
-    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
-                      [](wchar_t lhs, wchar_t rhs) { return CharUpper(reinterpret_cast<LPWSTR>(lhs)) == CharUpper(reinterpret_cast<LPWSTR>(rhs)); });
-  });
-  misspelled_words.erase(it, misspelled_words.end());
-  std::wstring str;
-  for (auto &s : misspelled_words)
-    str += std::wstring{s} + L'\n';
-  misspelled_words.clear();
-  return str;
+  return complete_misspelling_index() != nullptr;
+}
+
+const MisspellingIndex *SpellChecker::complete_misspelling_index() const {
+  auto it = m_misspelling_indices.find(m_editor.active_document_path());
+  if (it == m_misspelling_indices.end() || !it->second.is_complete(m_editor.get_active_document_length()))
+    return nullptr;
+  return &it->second;
+}
+
+void SpellChecker::on_style_changed(TextPosition pos, TextPosition length) {
+  auto it = m_dirty_ranges.find(m_editor.active_document_path());
+  // only matters if there's partial recheck pending, otherwise whole visible area will be rechecked anyway
+  if (it == m_dirty_ranges.end())
+    return;
+  it->second.add(pos, pos + length);
+}
+
+void SpellChecker::recheck_modified() {
+  auto it = m_dirty_ranges.find(m_editor.active_document_path());
+  if (it == m_dirty_ranges.end())
+    return recheck_visible();
+
+  auto ranges = std::move(it->second);
+  m_dirty_ranges.erase(it);
+  if (!m_speller_container.active_speller().is_working() ||
+      !SpellCheckerHelpers::is_spell_checking_needed_for_file(m_editor, m_settings))
+    return recheck_visible();
+
+  auto [first_visible_line, last_visible_line] = get_visible_line_range();
+  const auto doc_length = m_editor.get_active_document_length();
+  TextPosition last_checked_line = -1;
+  std::vector<MappedWstring> texts;
+  for (auto &interval : ranges.intervals()) {
+    auto begin = prev_token_begin_in_document(std::min(interval.begin, doc_length));
+    auto end = next_token_end_in_document(std::min(interval.end, doc_length));
+    auto first_line = std::max(static_cast<TextPosition>(m_editor.line_from_position(begin)), first_visible_line);
+    first_line = std::max(first_line, last_checked_line + 1);
+    auto last_line = std::min(static_cast<TextPosition>(m_editor.line_from_position(end)), last_visible_line);
+    if (first_line > last_line)
+      continue;
+    collect_visible_texts(first_line, last_line, texts);
+    last_checked_line = last_line;
+  }
+  underline_misspelled_words(std::move(texts), false);
+}
+
+MisspellingReport SpellChecker::get_misspelling_report() const {
+  ACTIVE_VIEW_BLOCK(m_editor);
+  MisspellingReport report;
+  if (auto index = complete_misspelling_index()) {
+    // text is fetched and decoded by chunks starting from misspellings, not for every one of them
+    const auto &misspellings = index->misspellings();
+    for (auto it = misspellings.begin(); it != misspellings.end();) {
+      const auto chunk_begin = (*it)[0];
+      const auto chunk_end = std::max(get_check_chunk_end(chunk_begin), (*it)[1]);
+      const auto text = m_editor.get_mapped_wstring_range(chunk_begin, chunk_end);
+      for (; it != misspellings.end() && (*it)[1] <= chunk_end; ++it) {
+        const auto word_start = static_cast<size_t>(text.from_original_index((*it)[0]));
+        const auto word_end = static_cast<size_t>(text.from_original_index((*it)[1]));
+        report.add(std::wstring_view(text.str).substr(word_start, word_end - word_start), (*it)[0]);
+      }
+    }
+    return report;
+  }
+
+  for_each_misspelling_in_active_document([&](std::wstring_view word, TextPosition word_start) { report.add(word, word_start); });
+  return report;
+}
+
+std::wstring SpellChecker::get_all_misspellings_as_string() const {
+  return get_misspelling_report().to_string();
 }
 
 void SpellChecker::mark_lines_with_misspelling() const {
   ACTIVE_VIEW_BLOCK(m_editor);
-  auto buf = m_editor.get_active_document_text();
-  auto mapped_str = m_editor.to_mapped_wstring(buf);
-  m_editor.force_style_update(mapped_str.mapping.front(), mapped_str.mapping.back());
-  auto misspelled_words = get_misspelled_words(mapped_str);
-  for (auto &misspelling : misspelled_words) {
-    auto start_index = misspelling.data() - mapped_str.str.data();
-    auto position = mapped_str.to_original_index(start_index);
-    auto line = m_editor.line_from_position(position);
-    m_editor.add_bookmark(line);
+  if (auto index = complete_misspelling_index()) {
+    for (auto &range : index->misspellings())
+      m_editor.add_bookmark(m_editor.line_from_position(range[0]));
+    return;
   }
+
+  for_each_misspelling_in_active_document([this](std::wstring_view, TextPosition word_start) { m_editor.add_bookmark(m_editor.line_from_position(word_start)); });
 }
@@ -15,8 +15,18 @@
 #pragma once
 // Class that will do most of the job with spellchecker
 
+#include "MisspellingIndex.h"
+#include "MisspellingReport.h"
+#include "WordVerdictCache.h"
+#include "lsignal.h"
+#include "common/IntervalSet.h"
+#include "common/TaskWrapper.h"
 #include "npp/EditorInterface.h"
 
+#include <array>
+#include <functional>
+#include <unordered_map>
+
 
 class EditorInterface;
 class Settings;
@@ -32,6 +42,7 @@ class NativeSpellerInterface;
 class WordForSpeller;
 class SpellerContainer;
 class SpellerWordData;
+class DocumentTextWindow;
 
 class SpellChecker {
   enum class CheckTextMode {
@@ -45,9 +56,36 @@ public:
   ~SpellChecker();
   void recheck_visible_both_views();
   void recheck_visible();
+  // Modifications of active document, recorded so that recheck_modified() could process only changed lines
+  void on_text_inserted(TextPosition pos, TextPosition length);
+  void on_text_deleted(TextPosition pos, TextPosition length);
+  void on_style_changed(TextPosition pos, TextPosition length);
+  // Recheck only visible lines touched by recorded modifications, whole visible area if nothing was recorded
+  void recheck_modified();
+  // Modification reported by Scintilla window other than active view: a view showing active document as well (already
+  // recorded then), other view or a hidden window editing documents shown in no view (e.g. replace in all opened documents)
+  void on_other_window_modified(HWND window);
+  // Drops everything kept for the document, another one could be opened with the same path later
+  void on_document_closed(const std::wstring &path);
+  // Check next chunk of active document for misspelling index, returns false if there's nothing left to do until
+  // misspelling_index_outdated is fired, which is also the case while speller query for the chunk is done on worker thread
+  bool update_misspelling_index();
+  bool is_misspelling_index_complete() const;
+  // Check next chunk of lines around visible area of active document in advance, so scrolled in lines are already underlined.
+  // Returns false if there's nothing left to do
+  bool prefetch_next_chunk();
+  void cancel_prefetch();
+  // Speller queries for visible text are done on worker thread from now on, results are posted back to `target_hwnd`
+  void enable_async_checking(HWND target_hwnd);
+  // Same but `runner` decides where `query` is done and when `apply` gets its results, e.g. synchronously in tests
+  using AsyncCheckRunner = std::function<void(std::function<std::vector<bool>()> query, std::function<void(std::vector<bool>)> apply)>;
+  void enable_async_checking(AsyncCheckRunner runner);
+  void cancel_async_checks();
 
+  MisspellingReport get_misspelling_report() const;
   std::wstring get_all_misspellings_as_string() const;
   void on_settings_changed();
+  void on_speller_status_changed();
   void find_next_mistake();
   void find_prev_mistake();
   WordForSpeller to_word_for_speller(std::wstring_view word) const;
@@ -57,27 +95,84 @@ public:
   void erase_all_misspellings();
   void mark_lines_with_misspelling() const;
 
+public:
+  // fired when misspelling index needs update_misspelling_index() calls to become complete again
+  mutable lsignal::signal<void()> misspelling_index_outdated;
+  // fired when there are lines around visible area to be checked by prefetch_next_chunk() calls
+  mutable lsignal::signal<void()> prefetch_scheduled;
+
 private:
-  void create_word_underline(TextPosition start, TextPosition end) const;
-  void remove_underline(TextPosition start, TextPosition end) const;
+  struct PreparedCheck;
+  struct AsyncCheck;
+
+  // Make underlines in [from, to) match `underlined`, touching only ranges which actually differ
+  void update_underlines(TextPosition from, TextPosition to, const std::vector<std::array<TextPosition, 2>> &underlined) const;
   void clear_all_underlines() const;
   bool check_word(std::wstring_view word,
                   TextPosition word_start) const;
   TextPosition prev_token_begin_in_document(TextPosition start) const;
   TextPosition next_token_end_in_document(TextPosition end) const;
+  // Same but reusing text already decoded in `window`, which is extended if needed
+  TextPosition prev_token_begin_in_document(DocumentTextWindow &window, TextPosition start) const;
+  TextPosition next_token_end_in_document(DocumentTextWindow &window, TextPosition end) const;
   MappedWstring get_visible_text();
+  std::array<TextPosition, 2> get_visible_line_range() const;
   void underline_misspelled_words_in_visible_text();
-  std::vector<SpellerWordData> check_text(const MappedWstring &text_to_check) const;
+  void collect_visible_texts(TextPosition first_line, TextPosition last_line, std::vector<MappedWstring> &texts);
+  void underline_misspelled_words_in_lines(TextPosition first_line, TextPosition last_line);
+  void schedule_prefetch();
+  // screens around all visible line ranges of the active document
+  void schedule_prefetch(const std::vector<std::array<TextPosition, 2>> &visible_line_ranges);
+  const MisspellingIndex *complete_misspelling_index() const;
+  void invalidate_misspelling_index_lines(MisspellingIndex &index, TextPosition from, TextPosition to) const;
+  void clear_misspelling_indices();
+  // Drops positions recorded for document modified elsewhere
+  void invalidate_document(const std::wstring &path);
+  // Calls `function` for each word of text which needs spell checking until it returns false
+  template <typename FunctionType> void for_each_word_to_check(const MappedWstring &text_to_check, const FunctionType &function) const;
+  // Same for UTF-8 text starting at `text_begin` in document, positions of words are byte offsets in document
+  template <typename FunctionType>
+  void for_each_utf8_word_to_check(std::string_view text, TextPosition text_begin, const FunctionType &function) const;
+  // Tokenizes and filters words of text, taking verdicts from cache where possible
+  PreparedCheck prepare_check(const MappedWstring &text_to_check) const;
+  // Applies speller `results` starting from `offset` to words which were not in cache, returns number of results used
+  size_t complete_check(PreparedCheck &check, const std::vector<bool> &results, size_t offset) const;
+  template <typename WordSourceType>
+  void check_by_batches(const WordSourceType &for_each_word, const std::function<bool(const SpellerWordData &)> &function) const;
+  // Same as prepare_check followed by speller check but words are streamed to speller in batches of limited size,
+  // `function` is called for each checked word in order until it returns false
+  void for_each_checked_word(const MappedWstring &text_to_check, const std::function<bool(const SpellerWordData &)> &function) const;
+  void for_each_checked_utf8_word(std::string_view text, TextPosition text_begin, const std::function<bool(const SpellerWordData &)> &function) const;
+  // Whether document text could be checked without conversion to wide string, which is the case for UTF-8 documents
+  // and spellers taking UTF-8 words
+  bool is_utf8_checking_possible() const;
+  // Checks active document by chunks so that memory use doesn't depend on its size
+  void for_each_misspelling_in_active_document(const std::function<void(std::wstring_view word, TextPosition word_start)> &function) const;
+  TextPosition get_check_chunk_end(TextPosition begin) const;
   void underline_misspelled_words(const MappedWstring &text_to_check, const TextPosition start_pos) const;
-  std::vector<std::wstring_view> get_misspelled_words(const MappedWstring &text_to_check) const;
+  void underline_misspelled_words(std::vector<MappedWstring> texts, bool covers_visible_area);
+  void apply_async_check(AsyncCheck &check, const std::vector<bool> &results);
+  // Speller query is done by `task` on worker thread (or by async check runner), `apply` gets its results on UI thread
+  void check_words_deferred(TaskWrapper &task, std::vector<WordForSpeller> words_for_speller, std::function<void(std::vector<bool>)> apply) const;
+  void apply_async_index_check(AsyncCheck &check, const std::vector<bool> &results);
+  bool is_async_checking_possible() const;
+  void cancel_async_check();
+  uint64_t document_generation(const std::wstring &path) const;
   std::optional<std::array<TextPosition, 2>> find_first_misspelling(const MappedWstring &text_to_check, TextPosition last_valid_position) const;
   std::optional<std::array<TextPosition, 2>> find_last_misspelling(const MappedWstring &text_to_check, TextPosition last_valid_position) const;
   void check_visible();
+  // Returns false if visible text of target view doesn't need to be checked, clearing its underlines
+  bool prepare_visible_recheck();
+  void recheck_visible_shared_document();
 
   std::wstring_view get_word_at(TextPosition char_pos, const MappedWstring &text) const;
+  // `utf8_word` is the same word in UTF-8 if it's already known
+  WordForSpeller to_word_for_speller(std::wstring_view word, bool ends_with_dot, std::string_view utf8_word) const;
   void refresh_underline_style();
   bool is_spellchecking_needed(std::wstring_view word,
                                TextPosition word_start) const;
+  bool is_spellchecking_needed(std::wstring_view word, const EditorStyleSnapshot &style_snapshot,
+                               TextPosition word_start) const;
   TextPosition next_token_end(std::wstring_view target, TextPosition index) const;
   TextPosition prev_token_begin(std::wstring_view target, TextPosition index) const;
 
@@ -86,4 +181,17 @@ private:
 
   EditorInterface &m_editor;
   const SpellerContainer &m_speller_container;
+  mutable WordVerdictCache m_verdict_cache;
+  std::unordered_map<std::wstring, IntervalSet<TextPosition>> m_dirty_ranges; // by document path
+  std::unordered_map<std::wstring, MisspellingIndex> m_misspelling_indices; // by document path
+  std::unordered_map<std::wstring, std::vector<std::array<TextPosition, 2>>> m_prefetch_line_ranges; // by document path, next one is the last
+  HWND m_async_target_hwnd = nullptr;
+  AsyncCheckRunner m_async_check_runner;
+  std::unordered_map<HWND, TaskWrapper> m_async_checks; // by view window, only the latest check of a view is applied
+  std::unordered_map<HWND, bool> m_async_check_pending; // by view window
+  std::optional<TaskWrapper> m_async_index_check;
+  bool m_async_index_check_pending = false;
+  // Results of async checks are dropped if generation of their document changed while they were done
+  uint64_t m_common_generation = 0; // increased when verdicts could change for every document
+  std::unordered_map<std::wstring, uint64_t> m_document_generations; // by document path, increased on modification
 };
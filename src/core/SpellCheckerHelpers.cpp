@@ -60,11 +60,11 @@ void apply_word_conversions(const Settings &settings, std::wstring &word) {
   }
 }
 
-static bool is_apostrophe(const Settings &settings, wchar_t chr) {
+bool is_apostrophe(wchar_t chr, bool convert_single_quotes) {
   if (chr == L'\'')
     return true;
 
-  if (settings.data.convert_single_quotes && chr == L'’')
+  if (convert_single_quotes && chr == L'’')
     return true;
 
   return false;
@@ -72,83 +72,132 @@ static bool is_apostrophe(const Settings &settings, wchar_t chr) {
 
 void cut_apostrophes(const Settings &settings, std::wstring_view &word) {
   if (settings.data.remove_boundary_apostrophes) {
-    while (!word.empty() && is_apostrophe(settings, word.front()))
+    while (!word.empty() && is_apostrophe(word.front(), settings.data.convert_single_quotes))
       word.remove_prefix(1);
 
-    while (!word.empty() && is_apostrophe(settings, word.back()))
+    while (!word.empty() && is_apostrophe(word.back(), settings.data.convert_single_quotes))
       word.remove_suffix(1);
   }
 }
 
 void replace_all_tokens(EditorInterface &editor, const Settings &settings, const char *from, std::wstring_view to, bool is_proper_name) {
-  TextPosition pos = 0;
-  auto from_len = static_cast<TextPosition>(strlen(from));
-  if (from_len == 0)
+  if (*from == '\0')
     return;
 
-  std::wstring modified_to(to);
-
-  while (true) {
-    pos = editor.find_next(pos, from);
-    if (pos >= 0) {
-      auto doc_word_start_pos = editor.get_prev_valid_begin_pos(pos);
-      auto doc_word_end_pos = editor.get_next_valid_end_pos(pos + from_len);
-      auto mapped_wstr = editor.get_mapped_wstring_range(doc_word_start_pos, doc_word_end_pos);
-      std::wstring_view src_word_sv;
-      TextPosition buf_word_start_pos = 0;
-      auto buf_word_end_pos = static_cast<TextPosition>(mapped_wstr.str.length());
-      if (!settings.do_with_tokenizer(mapped_wstr.str, [&](const auto &tokenizer) {
-        TextPosition end_pos_offset = 0;
-        if (doc_word_end_pos != pos + from_len)
-          end_pos_offset = 1;
-        TextPosition start_pos_offset = 0;
-        if (doc_word_start_pos != pos)
-          start_pos_offset = 1;
-
-        buf_word_start_pos += start_pos_offset;
-        buf_word_end_pos -= end_pos_offset;
-
-        if (start_pos_offset != 0) {
-          if (tokenizer.prev_token_begin(buf_word_end_pos - 1) != buf_word_start_pos)
-            return false;
-        }
-        if (end_pos_offset != 0) {
-          if (tokenizer.next_token_end(buf_word_start_pos) != buf_word_end_pos)
-            return false;
-        }
-        src_word_sv = std::wstring_view(mapped_wstr.str).substr(buf_word_start_pos, buf_word_end_pos - buf_word_start_pos);
-        if (!SpellCheckerHelpers::is_word_spell_checking_needed(settings, editor, src_word_sv, doc_word_start_pos + start_pos_offset))
-          return false;
+  const auto from_wstr = editor.to_mapped_wstring(from).str;
+  const auto buf = editor.get_active_document_text();
+  const auto mapped_str = editor.to_mapped_wstring(buf);
 
-        return true;
-      })) {
-        pos = pos + from_len;
+  std::vector<TextReplacement> replacements;
+  std::wstring modified_to;
+  settings.do_with_tokenizer(mapped_str.str, [&](const auto &tokenizer) {
+    for (auto token : tokenizer.tokens()) {
+      if (!std::equal(token.begin(), token.end(), from_wstr.begin(), from_wstr.end(),
+                      [](wchar_t lhs, wchar_t rhs) { return lhs == rhs || make_lower(lhs) == make_lower(rhs); }))
+        continue;
+      const auto token_start = static_cast<TextPosition>(token.data() - mapped_str.str.data());
+      const auto doc_token_start = mapped_str.to_original_index(token_start);
+      if (!is_word_spell_checking_needed(settings, editor, token, doc_token_start))
         continue;
-      }
 
-      bool use_modified = false;
+      auto replacement = to;
       if (!is_proper_name) {
-        auto src_case_type = get_string_case_type(src_word_sv);
+        auto src_case_type = get_string_case_type(token);
         if (src_case_type != string_case_type::mixed) {
+          modified_to = to;
           apply_case_type(modified_to, src_case_type);
-          use_modified = true;
+          replacement = modified_to;
         }
       }
-      auto encoded_to = editor.to_editor_encoding(use_modified ? modified_to : to);
-      editor.replace_text(pos, pos + from_len, encoded_to);
-      pos = pos + static_cast<TextPosition>(encoded_to.length());
-    } else
-      break;
+      replacements.push_back({doc_token_start, mapped_str.to_original_index(token_start + static_cast<TextPosition>(token.length())),
+                              editor.to_editor_encoding(replacement)});
+    }
+  });
+  replace_ranges(editor, buf, replacements);
+}
+
+namespace {
+using ReplacementIterator = std::vector<TextReplacement>::const_iterator;
+
+// Replaces text from the first to the last replacement with a single edit
+void replace_at_once(EditorInterface &editor, std::string_view text, ReplacementIterator begin, ReplacementIterator end) {
+  const auto from = begin->from;
+  const auto to = std::prev(end)->to;
+  std::string result;
+  result.reserve(to - from);
+  auto kept_start = from;
+  for (auto it = begin; it != end; ++it) {
+    result.append(text.substr(kept_start, it->from - kept_start));
+    result += it->text;
+    kept_start = it->to;
   }
+  editor.replace_text(from, to, result);
 }
 
-bool is_word_spell_checking_needed(const Settings &settings, const EditorInterface &editor, std::wstring_view word,
-                                   TextPosition word_start) {
-  if (word.empty())
-    return false;
+std::vector<TextPosition> get_marked_lines(const EditorInterface &editor, TextPosition from_line, TextPosition to_line) {
+  std::vector<TextPosition> result;
+  for (auto line = editor.get_next_marked_line(from_line); line >= 0 && line <= to_line; line = editor.get_next_marked_line(line + 1))
+    result.push_back(line);
+  return result;
+}
 
-  auto style = editor.get_style_at(word_start);
-  auto lexer = editor.get_lexer();
+// Replacements are applied starting from the last one so that positions of the rest stay valid
+void apply_replacements(EditorInterface &editor, std::string_view text, ReplacementIterator begin, ReplacementIterator end) {
+  if (begin == end)
+    return;
+
+  // Few separate edits keep bookmarks and other line markers intact
+  constexpr ptrdiff_t max_separate_edit_count = 64;
+  if (end - begin <= max_separate_edit_count) {
+    for (auto it = std::make_reverse_iterator(end); it != std::make_reverse_iterator(begin); ++it)
+      editor.replace_text(it->from, it->to, it->text);
+    return;
+  }
+
+  // Every edit moves the rest of the document and sends its own notification, so with lots of them
+  // text between edits is rebuilt and replaced at once. Line markers and URLs of that text would be lost,
+  // so edits are split wherever kept text has them
+  const auto marked_lines = get_marked_lines(editor, editor.line_from_position(begin->from), editor.line_from_position(std::prev(end)->to));
+  const auto url_ranges = editor.get_indicator_ranges(URL_INDIC, begin->from, std::prev(end)->to);
+  auto url_it = url_ranges.begin();
+  auto has_markers_or_urls = [&](TextPosition kept_from, TextPosition kept_to) {
+    while (url_it != url_ranges.end() && (*url_it)[1] <= kept_from)
+      ++url_it;
+    if (url_it != url_ranges.end() && (*url_it)[0] < kept_to)
+      return true;
+    if (marked_lines.empty())
+      return false;
+    // marker of a line is lost only if line break before it is removed
+    const auto marked_line = std::upper_bound(marked_lines.begin(), marked_lines.end(), editor.line_from_position(kept_from));
+    return marked_line != marked_lines.end() && *marked_line <= editor.line_from_position(kept_to);
+  };
+
+  std::vector<ReplacementIterator> group_starts = {begin};
+  for (auto it = std::next(begin); it != end; ++it)
+    if (has_markers_or_urls(std::prev(it)->to, it->from))
+      group_starts.push_back(it);
+  auto group_end = end;
+  for (auto group_start = group_starts.rbegin(); group_start != group_starts.rend(); ++group_start) {
+    replace_at_once(editor, text, *group_start, group_end);
+    group_end = *group_start;
+  }
+}
+} // namespace
+
+void replace_ranges(EditorInterface &editor, std::string_view text, const std::vector<TextReplacement> &replacements) {
+  // Merged edit should not contain caret, otherwise it would be moved to the start of the edit
+  const auto caret_pos = editor.get_current_pos();
+  const auto split = std::find_if(replacements.begin(), replacements.end(), [caret_pos](const TextReplacement &replacement) {
+    return replacement.to > caret_pos;
+  });
+  apply_replacements(editor, text, split, replacements.end());
+  apply_replacements(editor, text, replacements.begin(), split);
+}
+
+// `is_url` is called only if needed, since it could be expensive
+template <typename IsUrlType>
+static bool is_word_spell_checking_needed_impl(const Settings &settings, std::wstring_view word, int lexer, int style,
+                                               const IsUrlType &is_url) {
   auto category = ScintillaUtils::get_style_category(lexer, style, settings);
   if (category == ScintillaUtils::StyleCategory::unknown) {
     return false;
@@ -162,52 +211,35 @@ bool is_word_spell_checking_needed(const Settings &settings, const EditorInterfa
   }
 
   // ignoring URLs new style:
-  if (editor.get_indicator_value_at(URL_INDIC, word_start) != 0)
-    return false;
-
-  if (static_cast<int>(word.length()) < settings.data.word_minimum_length)
-    return false;
-
-  if (settings.data.ignore_one_letter && word.length() == 1)
+  if (is_url())
     return false;
 
-  if (settings.data.ignore_containing_digit &&
-      std::find_if(word.begin(), word.end(), [](wchar_t wc) { return IsCharAlphaNumeric(wc) && !IsCharAlpha(wc); }) != word.end())
+  if (!settings.get_word_filter().accepts(word))
     return false;
 
-  if (settings.data.ignore_starting_with_capital && IsCharUpper(word.front())) {
-    return false;
-  }
-
-  if (settings.data.ignore_having_a_capital || settings.data.ignore_all_capital) {
-    bool all_upper = IsCharUpper(word.front()), any_upper = false;
-    for (auto c : std::wstring_view(word).substr(1)) {
-      if (IsCharUpper(c)) {
-        any_upper = true;
-      } else
-        all_upper = false;
-    }
-
-    if (!all_upper && any_upper && settings.data.ignore_having_a_capital)
+  if (const auto matcher = settings.get_ignore_regexp ())
+    if (matcher->matches(word))
       return false;
 
-    if (all_upper && settings.data.ignore_all_capital)
-      return false;
-  }
+  return true;
+}
 
-  if (settings.data.ignore_having_underscore && word.find(L'_') != std::wstring_view::npos)
+bool is_word_spell_checking_needed(const Settings &settings, const EditorInterface &editor, std::wstring_view word,
+                                   TextPosition word_start) {
+  if (word.empty())
     return false;
 
-  if (settings.data.ignore_starting_or_ending_with_apostrophe) {
-    if (is_apostrophe(settings, word.front()) || is_apostrophe(settings, word.back()))
-      return false;
-  }
+  return is_word_spell_checking_needed_impl(settings, word, editor.get_lexer(), editor.get_style_at(word_start),
+                                            [&] { return editor.get_indicator_value_at(URL_INDIC, word_start) != 0; });
+}
 
-  if (const auto regexp_ptr = settings.get_ignore_regexp ())
-    if (std::regex_match(word.begin (), word.end (), *regexp_ptr))
-      return false;
+bool is_word_spell_checking_needed(const Settings &settings, const EditorStyleSnapshot &style_snapshot, std::wstring_view word,
+                                   TextPosition word_start) {
+  if (word.empty())
+    return false;
 
-  return true;
+  return is_word_spell_checking_needed_impl(settings, word, style_snapshot.lexer, style_snapshot.style_at(word_start),
+                                            [&] { return style_snapshot.is_url_at(word_start); });
 }
 
 void replace_current_word_with_topmost_suggestion(EditorInterface &editor, const SpellChecker &spell_checker, const SpellerContainer &speller_container) {
@@ -215,7 +247,10 @@ void replace_current_word_with_topmost_suggestion(EditorInterface &editor, const
   if (!spell_checker.is_word_under_cursor_correct(pos, length, true)) {
     ACTIVE_VIEW_BLOCK(editor);
     const auto wstr = editor.get_mapped_wstring_range(pos, pos + length);
-    const auto suggestions = speller_container.active_speller().get_suggestions(wstr.str.c_str());
+    const auto suggestions = [&] {
+      auto lock = lock_spellers();
+      return speller_container.active_speller().get_suggestions(wstr.str.c_str());
+    }();
     if (!suggestions.empty()) {
       const auto converted_suggestion = editor.to_editor_encoding(suggestions.front());
       editor.replace_text(pos, pos + length, converted_suggestion);
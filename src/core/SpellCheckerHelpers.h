@@ -16,19 +16,33 @@
 
 class Settings;
 class EditorInterface;
+class EditorStyleSnapshot;
 class SpellerContainer;
 enum class NppViewType;
 
 #include "plugin/Constants.h"
 
 namespace SpellCheckerHelpers {
+struct TextReplacement {
+  TextPosition from;
+  TextPosition to;
+  std::string text; // in editor encoding
+};
+
 bool is_spell_checking_needed_for_file(const EditorInterface &editor, const Settings &settings);
 void apply_word_conversions(const Settings &settings, std::wstring &word);
+// `convert_single_quotes` setting makes right single quotation mark an apostrophe too
+bool is_apostrophe(wchar_t chr, bool convert_single_quotes);
 void cut_apostrophes(const Settings &settings, std::wstring_view &word);
 // Replace all tokens equal `from` to `to`. Settings are required for tokenization style.
 // If to is proper name or abbreviation it should be capitalized correctly otherwise it should be all lower case
 void replace_all_tokens(EditorInterface &editor, const Settings &settings, const char *from, std::wstring_view to, bool
                         is_proper_name);
+// Applies sorted non-overlapping replacements to active document, `text` is its current text.
+// Lots of replacements are merged into single edits, so it should be done inside UNDO_BLOCK.
+void replace_ranges(EditorInterface &editor, std::string_view text, const std::vector<TextReplacement> &replacements);
 bool is_word_spell_checking_needed(const Settings &settings, const EditorInterface &editor, std::wstring_view word, TextPosition word_start);
+// Same but with styles taken from snapshot of range containing the word
+bool is_word_spell_checking_needed(const Settings &settings, const EditorStyleSnapshot &style_snapshot, std::wstring_view word, TextPosition word_start);
 void replace_current_word_with_topmost_suggestion(EditorInterface &editor, const SpellChecker &spell_checker, const SpellerContainer &speller_container);
 } // namespace SpellCheckerHelpers
@@ -0,0 +1,107 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "WordFilter.h"
+
+#include "core/SpellCheckerHelpers.h"
+
+#include "plugin/Settings.h"
+
+namespace {
+enum class CharClass {
+  digit,
+  upper,
+  other,
+};
+
+// ASCII is classified directly, results are the same as with winapi functions
+CharClass classify(wchar_t c) {
+  if (c < 0x80) {
+    if (c >= L'0' && c <= L'9')
+      return CharClass::digit;
+    if (c >= L'A' && c <= L'Z')
+      return CharClass::upper;
+    return CharClass::other;
+  }
+  if (IsCharAlphaNumeric(c) && !IsCharAlpha(c))
+    return CharClass::digit;
+  if (IsCharUpper(c))
+    return CharClass::upper;
+  return CharClass::other;
+}
+} // namespace
+
+WordFilter WordFilter::compile(const Settings &settings) {
+  WordFilter filter;
+  auto &data = settings.data;
+  filter.m_minimum_length = data.word_minimum_length;
+  filter.m_ignore_one_letter = data.ignore_one_letter;
+  filter.m_ignore_starting_with_capital = data.ignore_starting_with_capital;
+  filter.m_ignore_having_a_capital = data.ignore_having_a_capital;
+  filter.m_ignore_all_capital = data.ignore_all_capital;
+  filter.m_ignore_containing_digit = data.ignore_containing_digit;
+  filter.m_ignore_having_underscore = data.ignore_having_underscore;
+  filter.m_ignore_starting_or_ending_with_apostrophe = data.ignore_starting_or_ending_with_apostrophe;
+  filter.m_convert_single_quotes = data.convert_single_quotes;
+  filter.m_needs_scan = data.ignore_having_a_capital || data.ignore_all_capital || data.ignore_containing_digit ||
+                        data.ignore_having_underscore;
+  return filter;
+}
+
+bool WordFilter::accepts(std::wstring_view word) const {
+  if (word.empty() || static_cast<int>(word.length()) < m_minimum_length)
+    return false;
+
+  if (m_ignore_one_letter && word.length() == 1)
+    return false;
+
+  if (m_ignore_starting_or_ending_with_apostrophe && (SpellCheckerHelpers::is_apostrophe(word.front(), m_convert_single_quotes) ||
+                                                     SpellCheckerHelpers::is_apostrophe(word.back(), m_convert_single_quotes)))
+    return false;
+
+  if (m_ignore_starting_with_capital && classify(word.front()) == CharClass::upper)
+    return false;
+
+  if (!m_needs_scan)
+    return true;
+
+  const bool check_capitals = m_ignore_having_a_capital || m_ignore_all_capital;
+  const bool classify_needed = check_capitals || m_ignore_containing_digit;
+  // all_upper is about the whole word, any_upper - about all letters except the first one
+  bool all_upper = true, any_upper = false;
+  for (size_t i = 0; i < word.length(); ++i) {
+    auto c = word[i];
+    if (m_ignore_having_underscore && c == L'_')
+      return false;
+    if (!classify_needed)
+      continue;
+
+    auto char_class = classify(c);
+    if (m_ignore_containing_digit && char_class == CharClass::digit)
+      return false;
+    if (char_class == CharClass::upper) {
+      if (i > 0)
+        any_upper = true;
+    } else
+      all_upper = false;
+
+    if (m_ignore_having_a_capital && any_upper && !all_upper)
+      return false;
+  }
+
+  if (check_capitals && all_upper && m_ignore_all_capital)
+    return false;
+
+  return true;
+}
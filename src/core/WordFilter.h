@@ -0,0 +1,41 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include <string_view>
+
+class Settings;
+
+// "Ignore" options from settings which depend only on word itself.
+// Compiled on settings change so that disabled checks are skipped and the rest are done in a single pass over the word.
+class WordFilter {
+public:
+  static WordFilter compile(const Settings &settings);
+  // false if word should not be spell checked
+  bool accepts(std::wstring_view word) const;
+
+private:
+  int m_minimum_length = 0;
+  bool m_ignore_one_letter = false;
+  bool m_ignore_starting_with_capital = false;
+  bool m_ignore_having_a_capital = false;
+  bool m_ignore_all_capital = false;
+  bool m_ignore_containing_digit = false;
+  bool m_ignore_having_underscore = false;
+  bool m_ignore_starting_or_ending_with_apostrophe = false;
+  bool m_convert_single_quotes = false;
+  // whether any check requiring a pass over all characters is enabled
+  bool m_needs_scan = false;
+};
@@ -0,0 +1,47 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "WordVerdictCache.h"
+
+std::optional<bool> WordVerdictCache::find(const WordForSpeller &word) const {
+  auto &map = map_for(word);
+  auto it = map.find(word.str);
+  if (it == map.end())
+    return std::nullopt;
+  return it->second;
+}
+
+void WordVerdictCache::insert(const WordForSpeller &word, bool is_correct) {
+  // Simple bound instead of proper eviction, refilling cache with visible words is cheap enough
+  if (size() >= max_size)
+    clear();
+  map_for(word)[word.str] = is_correct;
+}
+
+void WordVerdictCache::clear() {
+  for (auto &map : m_maps)
+    map.clear();
+}
+
+size_t WordVerdictCache::size() const {
+  return m_maps[0].size() + m_maps[1].size();
+}
+
+WordVerdictCache::MapType &WordVerdictCache::map_for(const WordForSpeller &word) {
+  return m_maps[word.data.ends_with_dot ? 1 : 0];
+}
+
+const WordVerdictCache::MapType &WordVerdictCache::map_for(const WordForSpeller &word) const {
+  return m_maps[word.data.ends_with_dot ? 1 : 0];
+}
@@ -0,0 +1,43 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include "spellers/SpellerInterface.h"
+
+#include <array>
+#include <optional>
+#include <unordered_map>
+
+// Remembers speller verdicts for words already seen so that rechecking unchanged text
+// (scrolling, cursor moves) does not go through the speller again.
+// Verdicts depend only on active speller state and settings, not on document, so single cache is shared between buffers.
+// Must be cleared whenever speller state or settings change.
+class WordVerdictCache {
+public:
+  std::optional<bool> find(const WordForSpeller &word) const;
+  void insert(const WordForSpeller &word, bool is_correct);
+  void clear();
+  size_t size() const;
+
+private:
+  using MapType = std::unordered_map<std::wstring, bool>;
+  MapType &map_for(const WordForSpeller &word);
+  const MapType &map_for(const WordForSpeller &word) const;
+
+private:
+  static constexpr size_t max_size = 1 << 16;
+  // indexed by ends_with_dot, since speller may treat such words differently
+  std::array<MapType, 2> m_maps;
+};
@@ -0,0 +1,100 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "DocumentTextWindow.h"
+
+#include "npp/EditorInterface.h"
+
+DocumentTextWindow::DocumentTextWindow(EditorInterface &editor, TextPosition position)
+  : m_editor(editor) {
+  reset(position);
+}
+
+void DocumentTextWindow::reset(TextPosition position) {
+  m_text.str.clear();
+  m_text.mapping.clear();
+  m_text.mapping.push_back(position);
+}
+
+bool DocumentTextWindow::extend_left(TextPosition length) {
+  if (begin() <= 0)
+    return false;
+
+  auto from = std::max(begin() - std::max(length, TextPosition{1}), TextPosition{0});
+  if (from > 0)
+    from = m_editor.get_prev_valid_begin_pos(from + 1);
+  auto part = m_editor.get_mapped_wstring_range(from, begin());
+  if (part.str.empty())
+    return false;
+
+  m_text.str.insert(0, part.str);
+  part.mapping.pop_back();
+  part.mapping.append(m_text.mapping);
+  m_text.mapping = std::move(part.mapping);
+  return true;
+}
+
+bool DocumentTextWindow::extend_right(TextPosition length) {
+  const auto doc_length = m_editor.get_active_document_length();
+  if (end() >= doc_length)
+    return false;
+
+  auto to = std::min(end() + std::max(length, TextPosition{1}), doc_length);
+  if (to < doc_length)
+    to = m_editor.get_prev_valid_begin_pos(to + 1);
+  if (to <= end())
+    to = m_editor.get_next_valid_end_pos(end());
+  auto part = m_editor.get_mapped_wstring_range(end(), to);
+  if (part.str.empty())
+    return false;
+
+  m_text.str += part.str;
+  m_text.mapping.pop_back();
+  m_text.mapping.append(part.mapping);
+  return true;
+}
+
+void DocumentTextWindow::extend_to(TextPosition position) {
+  if (position < begin())
+    extend_left(begin() - position);
+  else if (position > end())
+    extend_right(position - end());
+}
+
+MappedWstring DocumentTextWindow::take_front(TextPosition index) {
+  MappedWstring result;
+  result.str = m_text.str.substr(0, index);
+  result.mapping = m_text.mapping.subrange(0, index + 1);
+  m_text.str.erase(0, index);
+  m_text.mapping.erase_front(index);
+  return result;
+}
+
+MappedWstring DocumentTextWindow::take_back(TextPosition index) {
+  MappedWstring result;
+  result.str = m_text.str.substr(index);
+  result.mapping = m_text.mapping.subrange(index, m_text.mapping.size());
+  m_text.str.erase(index);
+  m_text.mapping.truncate(index + 1);
+  return result;
+}
+
+MappedWstring DocumentTextWindow::text(TextPosition from, TextPosition to) const {
+  const auto first = std::min(from_original_index(from), length());
+  const auto last = std::clamp(from_original_index(to), first, length());
+  MappedWstring result;
+  result.str = m_text.str.substr(first, last - first);
+  result.mapping = m_text.mapping.subrange(first, last + 1);
+  return result;
+}
@@ -0,0 +1,50 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include "plugin/Constants.h"
+
+class EditorInterface;
+
+// Decoded text of a document range growing in both directions, already decoded part is never fetched again.
+// Positions at both ends are always on character boundaries.
+class DocumentTextWindow {
+public:
+  // Empty window at `position`
+  DocumentTextWindow(EditorInterface &editor, TextPosition position);
+  // Make window empty at `position`
+  void reset(TextPosition position);
+  // Extend window by about `length` bytes of document, returns false if document boundary is reached already
+  bool extend_left(TextPosition length);
+  bool extend_right(TextPosition length);
+  // Extend window so it includes `position`
+  void extend_to(TextPosition position);
+  // Remove text before/after `index` from window and return it
+  MappedWstring take_front(TextPosition index);
+  MappedWstring take_back(TextPosition index);
+  // Copy of text between document positions inside the window
+  MappedWstring text(TextPosition from, TextPosition to) const;
+
+  const std::wstring &str() const { return m_text.str; }
+  TextPosition length() const { return static_cast<TextPosition>(m_text.str.length()); }
+  TextPosition begin() const { return m_text.mapping.front(); }
+  TextPosition end() const { return m_text.mapping.back(); }
+  TextPosition to_original_index(TextPosition index) const { return m_text.to_original_index(index); }
+  TextPosition from_original_index(TextPosition position) const { return m_text.from_original_index(position); }
+
+private:
+  EditorInterface &m_editor;
+  MappedWstring m_text; // mapping always has length() + 1 entries
+};
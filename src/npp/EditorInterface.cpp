@@ -19,6 +19,18 @@
 #include "common/Utility.h"
 #include <cassert>
 
+int EditorStyleSnapshot::style_at(TextPosition position) const {
+  auto index = position - from;
+  ASSERT_RETURN(index >= 0 && index < static_cast<TextPosition>(styles.size()), 0);
+  return styles[index];
+}
+
+bool EditorStyleSnapshot::is_url_at(TextPosition position) const {
+  auto it = std::upper_bound(url_ranges.begin(), url_ranges.end(), position,
+                             [](TextPosition pos, const std::array<TextPosition, 2> &range) { return pos < range[1]; });
+  return it != url_ranges.end() && (*it)[0] <= position;
+}
+
 POINT EditorInterface::get_point_from_position(TextPosition position) const {
   return {get_point_x_from_position(position),
           get_point_y_from_position(position)};
@@ -61,6 +73,32 @@ std::string EditorInterface::to_editor_encoding(std::wstring_view str) const {
   throw std::runtime_error("Unsupported encoding");
 }
 
+std::vector<std::array<TextPosition, 2>> EditorInterface::get_indicator_ranges(int indicator_id, TextPosition from, TextPosition to) const {
+  std::vector<std::array<TextPosition, 2>> result;
+  // walking over runs of the same value, so it takes a message per run instead of per position
+  for (auto pos = from; pos < to;) {
+    bool is_set = get_indicator_value_at(indicator_id, pos) != 0;
+    auto run_end = get_indicator_end(indicator_id, pos);
+    if (run_end <= pos || run_end > to)
+      run_end = to;
+    if (is_set)
+      result.push_back({pos, run_end});
+    pos = run_end;
+  }
+  return result;
+}
+
+EditorStyleSnapshot EditorInterface::get_style_snapshot(TextPosition from, TextPosition to) const {
+  EditorStyleSnapshot snapshot;
+  snapshot.lexer = get_lexer();
+  snapshot.from = from;
+  if (from < to) {
+    snapshot.styles = get_styles(from, to);
+    snapshot.url_ranges = get_indicator_ranges(URL_INDIC, from, to);
+  }
+  return snapshot;
+}
+
 MappedWstring EditorInterface::to_mapped_wstring(const std::string &str) {
   if (get_encoding() == EditorCodepage::utf8)
     return utf8_to_mapped_wstring(str);
@@ -70,7 +108,6 @@ MappedWstring EditorInterface::to_mapped_wstring(const std::string &str) {
 
 MappedWstring EditorInterface::get_mapped_wstring_range(TextPosition from, TextPosition to) {
   auto result = to_mapped_wstring(get_text_range(from, to));
-  for (auto &val : result.mapping)
-    val += from;
+  result.mapping.shift(from);
   return result;
 }
@@ -18,6 +18,7 @@
 #include "common/Utility.h"
 #include "plugin/Constants.h"
 
+#include <array>
 #include <optional>
 #include <string>
 #include <vector>
@@ -42,6 +43,19 @@ public:
   int h;
 };
 
+// Styles and URL indicator of a document range fetched at once, to avoid querying them per position
+class EditorStyleSnapshot {
+public:
+  int style_at(TextPosition position) const;
+  bool is_url_at(TextPosition position) const;
+
+public:
+  int lexer = 0;
+  TextPosition from = 0;
+  std::vector<int> styles; // styles of positions starting from `from`
+  std::vector<std::array<TextPosition, 2>> url_ranges; // sorted
+};
+
 class EditorInterface {
 public:
   // non-const
@@ -92,6 +106,8 @@ public:
   virtual int line_from_position(TextPosition position) const = 0;
   virtual TextPosition get_line_start_position(TextPosition line) const = 0;
   virtual TextPosition get_line_end_position(TextPosition line) const = 0;
+  // first line starting from `line` which has any marker (bookmark etc.), -1 if there is none
+  virtual TextPosition get_next_marked_line(TextPosition line) const = 0;
   virtual int get_lexer() const = 0;
   virtual std::optional<TextPosition>
   char_position_from_global_point(int x, int y) const = 0;
@@ -101,8 +117,14 @@ public:
   virtual TextPosition get_selection_end() const = 0;
   virtual HWND get_editor_hwnd() const = 0;
   virtual HWND get_view_hwnd() const = 0;
+  // whether Scintilla `window` shows the same document as target view, e.g. when it's cloned to other view
+  virtual bool shows_same_document(HWND window) const = 0;
   virtual int get_style_at(TextPosition position) const = 0;
   virtual int get_indicator_value_at(int indicator_id, TextPosition position) const = 0;
+  // end of the run of positions having the same indicator value as `position`
+  virtual TextPosition get_indicator_end(int indicator_id, TextPosition position) const = 0;
+  // styles of positions in [from, to)
+  virtual std::vector<int> get_styles(TextPosition from, TextPosition to) const = 0;
   virtual std::wstring get_full_current_path() const = 0;
   // is current style used for links (hotspots):
   virtual TextPosition get_active_document_length() const = 0;
@@ -133,6 +155,9 @@ public:
   MappedWstring to_mapped_wstring(const std::string &str);
   MappedWstring get_mapped_wstring_range(TextPosition from, TextPosition to);
   std::string to_editor_encoding(std::wstring_view str) const;
+  // ranges inside [from, to) which have non-zero value of indicator
+  std::vector<std::array<TextPosition, 2>> get_indicator_ranges(int indicator_id, TextPosition from, TextPosition to) const;
+  EditorStyleSnapshot get_style_snapshot(TextPosition from, TextPosition to) const;
   virtual int get_first_visible_column() const = 0;
 
   virtual ~EditorInterface() = default;
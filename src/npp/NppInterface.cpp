@@ -45,6 +45,15 @@ void NppInterface::set_menu_item_check(int cmd_id, bool checked) { send_msg_to_n
 
 HMENU NppInterface::get_menu_handle(int menu_type) const { return reinterpret_cast<HMENU>(send_msg_to_npp(NPPM_GETMENUHANDLE, menu_type)); }
 
+std::wstring NppInterface::path_from_buffer_id(UINT_PTR buffer_id) const {
+  auto length = send_msg_to_npp(NPPM_GETFULLPATHFROMBUFFERID, buffer_id, 0);
+  if (length < 0)
+    return {};
+  std::vector<wchar_t> buf(length + 1);
+  send_msg_to_npp(NPPM_GETFULLPATHFROMBUFFERID, buffer_id, reinterpret_cast<LPARAM>(buf.data()));
+  return buf.data();
+}
+
 int NppInterface::get_target_view() const {
   return static_cast<int>(m_target_view);
 }
@@ -53,6 +62,10 @@ int NppInterface::get_indicator_value_at(int indicator_id, TextPosition position
   return static_cast<int>(send_msg_to_scintilla(SCI_INDICATORVALUEAT, indicator_id, position));
 }
 
+TextPosition NppInterface::get_indicator_end(int indicator_id, TextPosition position) const {
+  return send_msg_to_scintilla(SCI_INDICATOREND, indicator_id, position);
+}
+
 int NppInterface::get_first_visible_column() const {
   const int x_offset = static_cast<int>(send_msg_to_scintilla(SCI_GETXOFFSET));
   const int pixel_width = static_cast<int>(send_msg_to_scintilla(SCI_TEXTWIDTH, STYLE_DEFAULT, reinterpret_cast<LPARAM>("P")));
@@ -76,6 +89,10 @@ HWND NppInterface::get_view_hwnd() const {
   return handle;
 }
 
+bool NppInterface::shows_same_document(HWND window) const {
+  return send_msg_to_scintilla(SCI_GETDOCPOINTER) == SendMessage(window, SCI_GETDOCPOINTER, 0, 0);
+}
+
 std::wstring NppInterface::get_editor_directory() const { return get_npp_directory(); }
 
 LRESULT NppInterface::send_msg_to_scintilla(UINT msg, WPARAM w_param, LPARAM l_param) const {
@@ -147,7 +164,14 @@ void NppInterface::activate_document(const std::wstring &filepath) {
   activate_document(static_cast<int>(it - fnames.begin()));
 }
 
-std::wstring NppInterface::active_document_path() const { return get_dir_msg(NPPM_GETFULLCURRENTPATH); }
+std::wstring NppInterface::active_document_path() const {
+  // NPPM_GETFULLCURRENTPATH is about active view only
+  auto view = to_index(m_target_view);
+  auto index = send_msg_to_npp(NPPM_GETCURRENTDOCINDEX, 0, view);
+  if (index < 0)
+    return {};
+  return path_from_buffer_id(send_msg_to_npp(NPPM_GETBUFFERIDFROMPOS, index, view));
+}
 
 void NppInterface::switch_to_file(const std::wstring &path) { send_msg_to_npp(NPPM_SWITCHTOFILE, 0, reinterpret_cast<LPARAM>(path.data())); }
 
@@ -212,11 +236,12 @@ void NppInterface::set_indicator_foreground(int indicator_index, int style) {
   send_msg_to_scintilla(SCI_INDICSETFORE, indicator_index, style);
 }
 
-void NppInterface::set_current_indicator(int indicator_index) { post_msg_to_scintilla(SCI_SETINDICATORCURRENT, indicator_index); }
+// Indicator changes are sent rather than posted, so that following indicator queries reflect them
+void NppInterface::set_current_indicator(int indicator_index) { send_msg_to_scintilla(SCI_SETINDICATORCURRENT, indicator_index); }
 
-void NppInterface::indicator_fill_range(TextPosition from, TextPosition to) { post_msg_to_scintilla(SCI_INDICATORFILLRANGE, from, to - from); }
+void NppInterface::indicator_fill_range(TextPosition from, TextPosition to) { send_msg_to_scintilla(SCI_INDICATORFILLRANGE, from, to - from); }
 
-void NppInterface::indicator_clear_range(TextPosition from, TextPosition to) { post_msg_to_scintilla(SCI_INDICATORCLEARRANGE, from, to - from); }
+void NppInterface::indicator_clear_range(TextPosition from, TextPosition to) { send_msg_to_scintilla(SCI_INDICATORCLEARRANGE, from, to - from); }
 
 TextPosition NppInterface::get_first_visible_line() const { return send_msg_to_scintilla(SCI_GETFIRSTVISIBLELINE); }
 
@@ -324,6 +349,10 @@ int NppInterface::line_from_position(TextPosition position) const {
   return static_cast<int>(send_msg_to_scintilla(SCI_LINEFROMPOSITION, position));
 }
 
+TextPosition NppInterface::get_next_marked_line(TextPosition line) const {
+  return send_msg_to_scintilla(SCI_MARKERNEXT, line, static_cast<LPARAM>(~0u));
+}
+
 std::wstring NppInterface::plugin_config_dir() const { return get_dir_msg(NPPM_GETPLUGINSCONFIGDIR); }
 
 TextPosition NppInterface::get_line_start_position(TextPosition line) const {
@@ -361,6 +390,22 @@ int NppInterface::get_style_at(TextPosition position) const { return static_cast
 
 TextPosition NppInterface::get_active_document_length() const { return send_msg_to_scintilla(SCI_GETLENGTH); }
 
+std::vector<int> NppInterface::get_styles(TextPosition from, TextPosition to) const {
+  if (from >= to)
+    return {};
+  Sci_TextRange range;
+  range.chrg.cpMin = static_cast<Sci_PositionCR>(from);
+  range.chrg.cpMax = static_cast<Sci_PositionCR>(to);
+  // filled with pairs of character and its style
+  std::vector<char> buf(2 * (range.chrg.cpMax - range.chrg.cpMin) + 2);
+  range.lpstrText = buf.data();
+  send_msg_to_scintilla(SCI_GETSTYLEDTEXT, 0, reinterpret_cast<LPARAM>(&range));
+  std::vector<int> styles(to - from);
+  for (size_t i = 0; i < styles.size(); ++i)
+    styles[i] = static_cast<unsigned char>(buf[2 * i + 1]);
+  return styles;
+}
+
 std::string NppInterface::get_text_range(TextPosition from, TextPosition to) const {
   if (from > to) {
     assert(false); // Incorrect request to Scintilla. Prevent possible crash.
@@ -74,6 +74,7 @@ public:
   std::wstring plugin_config_dir() const override;
   TextPosition get_line_start_position(TextPosition line) const override;
   TextPosition get_line_end_position(TextPosition line) const override;
+  TextPosition get_next_marked_line(TextPosition line) const override;
   HWND get_editor_hwnd() const override;
   // please hook it up to notify to simplify usage of certain caches
   void notify(SCNotification *notify_code);
@@ -107,11 +108,15 @@ public:
   void set_target_view(int view_index) const override;
 
   HMENU get_menu_handle(int menu_type) const;
+  std::wstring path_from_buffer_id(UINT_PTR buffer_id) const;
   int get_target_view() const override;
   int get_indicator_value_at(int indicator_id, TextPosition position) const override;
+  TextPosition get_indicator_end(int indicator_id, TextPosition position) const override;
+  std::vector<int> get_styles(TextPosition from, TextPosition to) const override;
   int get_first_visible_column() const override;
 
   HWND get_view_hwnd() const override;
+  bool shows_same_document(HWND window) const override;
   std::wstring get_editor_directory() const override;
 
 private:
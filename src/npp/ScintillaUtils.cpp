@@ -17,8 +17,11 @@
 #include "SciLexer.h"
 #include "plugin/Settings.h"
 
+#include <utility>
+
 namespace ScintillaUtils {
-StyleCategory get_style_category(LRESULT lexer, LRESULT style, const Settings &settings) {
+namespace {
+constexpr StyleCategory evaluate_style_category_impl(LRESULT lexer, LRESULT style, bool check_default_udl_style) {
   using s = StyleCategory;
   switch (lexer) {
   case SCLEX_CONTAINER:
@@ -47,7 +50,7 @@ StyleCategory get_style_category(LRESULT lexer, LRESULT style, const Settings &s
     case SCE_USER_STYLE_IDENTIFIER:
       return s::identifier;
     case SCE_USER_STYLE_DEFAULT:
-      return settings.data.check_default_udl_style ? s::text : s::identifier;
+      return check_default_udl_style ? s::text : s::identifier;
     default:
       return s::unknown;
     }
@@ -1404,4 +1407,48 @@ StyleCategory get_style_category(LRESULT lexer, LRESULT style, const Settings &s
     return s::unknown;
   }
 }
+
+// Lexers below SCLEX_USER do not depend on settings so their rows are computed at compile time.
+// Every row is a separate constant so that its evaluation stays within compiler constexpr limits.
+constexpr LRESULT static_lexer_count = SCLEX_USER;
+
+template <LRESULT Lexer>
+constexpr StyleCategoryRow make_style_category_row() {
+  StyleCategoryRow row{};
+  for (int style = 0; style < style_count; ++style)
+    row[style] = evaluate_style_category_impl(Lexer, style, false);
+  return row;
+}
+
+template <LRESULT Lexer>
+constexpr StyleCategoryRow style_category_row = make_style_category_row<Lexer>();
+
+template <size_t... Lexers>
+constexpr std::array<const StyleCategoryRow *, sizeof...(Lexers)> make_style_category_table(std::index_sequence<Lexers...>) {
+  return {&style_category_row<static_cast<LRESULT>(Lexers)>...};
+}
+
+constexpr auto style_category_table = make_style_category_table(std::make_index_sequence<static_lexer_count>{});
+} // namespace
+
+StyleCategory get_style_category(LRESULT lexer, LRESULT style, const Settings &settings) {
+  if (style >= 0 && style < style_count) {
+    if (lexer >= 0 && lexer < static_lexer_count)
+      return (*style_category_table[lexer])[style];
+    if (lexer == SCLEX_USER)
+      return settings.get_udl_style_categories()[style];
+  }
+  return evaluate_style_category_impl(lexer, style, settings.data.check_default_udl_style);
+}
+
+StyleCategory evaluate_style_category(LRESULT lexer, LRESULT style, bool check_default_udl_style) {
+  return evaluate_style_category_impl(lexer, style, check_default_udl_style);
+}
+
+StyleCategoryRow make_udl_style_categories(bool check_default_udl_style) {
+  StyleCategoryRow row{};
+  for (int style = 0; style < style_count; ++style)
+    row[style] = evaluate_style_category_impl(SCLEX_USER, style, check_default_udl_style);
+  return row;
+}
 } // namespace ScintillaUtils
@@ -14,8 +14,12 @@
 
 #pragma once
 
+#include <array>
+
+class Settings;
+
 namespace ScintillaUtils {
-enum class StyleCategory {
+enum class StyleCategory : unsigned char {
   text,
   // should be spell-checked
   comment,
@@ -27,5 +31,12 @@ enum class StyleCategory {
   COUNT,
 };
 
+constexpr int style_count = 256;
+using StyleCategoryRow = std::array<StyleCategory, style_count>;
+
 StyleCategory get_style_category(LRESULT lexer, LRESULT style, const Settings &settings);
+// Evaluation without lookup tables, get_style_category should be used instead
+StyleCategory evaluate_style_category(LRESULT lexer, LRESULT style, bool check_default_udl_style);
+// Categories of user defined language styles, cached in settings since they depend on them
+StyleCategoryRow make_udl_style_categories(bool check_default_udl_style);
 } // namespace ScintillaUtils
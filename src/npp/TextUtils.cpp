@@ -3,35 +3,84 @@
 #include "common/Utility.h"
 #include "common/utf8.h"
 
+#include <bit>
+#include <cwchar>
+
+#if (defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)) && WCHAR_MAX == 0xFFFF
+#include <emmintrin.h>
+#define DSPELLCHECK_SSE2
+#endif
+
+namespace {
+constexpr ptrdiff_t ascii_block_size = 16;
+
+// Returns number of leading ASCII bytes in block of `ascii_block_size` bytes
+int ascii_prefix_length(const char *block) {
+#ifdef DSPELLCHECK_SSE2
+  const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block))));
+  return mask == 0 ? static_cast<int>(ascii_block_size) : std::countr_zero(mask);
+#else
+  for (int half = 0; half < 2; ++half) {
+    uint64_t word;
+    memcpy(&word, block + half * 8, sizeof(word));
+    if (const auto high_bits = word & 0x8080808080808080ull; high_bits != 0)
+      return half * 8 + std::countr_zero(high_bits) / 8;
+  }
+  return static_cast<int>(ascii_block_size);
+#endif
+}
+
+void widen_ascii_block(const char *block, wchar_t *out) {
+#ifdef DSPELLCHECK_SSE2
+  const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block));
+  const auto zero = _mm_setzero_si128();
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi8(bytes, zero));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), _mm_unpackhi_epi8(bytes, zero));
+#else
+  for (ptrdiff_t i = 0; i < ascii_block_size; ++i)
+    out[i] = static_cast<unsigned char>(block[i]);
+#endif
+}
+} // namespace
+
 MappedWstring utf8_to_mapped_wstring(std::string_view str) {
   if (str.empty())
     return {};
-  ptrdiff_t len = str.length();
-  std::vector<wchar_t> buf;
-  std::vector<TextPosition> mapping;
-  buf.reserve(len);
-  mapping.reserve(len);
-  auto it = str.data();
+  const auto data = str.data();
+  const auto end = data + str.length();
+  auto it = data;
   // sadly this garbage skipping is required due to bad find prev mistake algorithm
-  while (utf8_is_cont(*it))
+  while (it != end && utf8_is_cont(*it))
     ++it;
-  size_t char_cnt = 1;
-  while (it - str.data() < len) {
-    auto next = utf8_inc(it);
-    buf.resize(char_cnt);
-    MultiByteToWideChar(CP_UTF8, 0, it, static_cast<int>(next - it), buf.data() + char_cnt - 1, 1);
-    mapping.push_back(it - str.data());
-    ++char_cnt;
-    it = next;
+  // every character takes at least one byte so string could be sized upfront
+  std::wstring result(end - it, L'\0');
+  MappedWstring::Mapping mapping;
+  auto out = result.data();
+  while (it != end) {
+    if (end - it >= ascii_block_size) {
+      const auto ascii_length = ascii_prefix_length(it);
+      if (ascii_length == ascii_block_size)
+        widen_ascii_block(it, out);
+      else
+        std::copy(it, it + ascii_length, out);
+      mapping.push_back_run(it - data, ascii_length);
+      it += ascii_length;
+      out += ascii_length;
+      if (ascii_length == ascii_block_size)
+        continue;
+    }
+    mapping.push_back(it - data);
+    *out++ = utf8_decode_bmp_char(it, end);
   }
-  mapping.push_back(it - str.data());
-  return {std::wstring{buf.begin(), buf.end()}, std::move(mapping)};
+  mapping.push_back(it - data);
+  result.resize(out - result.data());
+  return {std::move(result), std::move(mapping)};
 }
 
 MappedWstring to_mapped_wstring(std::string_view str) {
   if (str.empty())
     return {};
-  std::vector<TextPosition> mapping(str.length() + 1);
-  std::iota(mapping.begin(), mapping.end(), 0);
+  MappedWstring::Mapping mapping;
+  mapping.push_back_run(0, static_cast<TextPosition>(str.length()) + 1);
   return {to_wstring(str), std::move(mapping)};
 }
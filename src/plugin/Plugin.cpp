@@ -219,7 +219,10 @@ void mark_lines_with_misspelling() {
 }
 
 void reload_hunspell_dictionaries() {
-  speller_container->get_hunspell_speller().reset_spellers();
+  {
+    auto lock = lock_spellers();
+    speller_container->get_hunspell_speller().reset_spellers();
+  }
   settings->settings_changed();
 }
 
@@ -411,6 +414,7 @@ void init_classes() {
   speller_container = std::make_unique<SpellerContainer>(settings.get(), &npp_data);
 
   spell_checker = std::make_unique<SpellChecker>(settings.get(), *npp, *speller_container);
+  spell_checker->enable_async_checking(npp_data.npp_handle);
 
   context_menu_handler = std::make_unique<ContextMenuHandler>(*settings, *speller_container, *npp, *spell_checker);
 
@@ -527,6 +531,12 @@ std::vector<std::pair<TextPosition, TextPosition>> check_queue;
 std::optional<WinApi::Timer> edit_recheck_timer;
 std::optional<WinApi::Timer> scroll_recheck_timer;
 constexpr int scroll_recheck_timer_resolution = 100;
+std::optional<WinApi::Timer> misspelling_index_timer;
+constexpr int misspelling_index_timer_resolution = 50;
+std::optional<WinApi::Timer> prefetch_timer;
+constexpr int prefetch_timer_resolution = 50;
+// background work of a single timer tick yields after this long
+constexpr auto background_time_slice = std::chrono::milliseconds(10);
 bool restyling_caused_recheck_was_done = false; // Hack to avoid eternal cycle in case of scintilla bug
 bool first_restyle = true;                      // hack to successfully avoid checking hyperlinks
 // when they appear on program start
@@ -672,12 +682,53 @@ void WINAPI edit_recheck_callback() {
   edit_recheck_timer->stop_timer();
 
   ACTIVE_VIEW_BLOCK(npp_interface());
-  spell_checker->recheck_visible();
+  spell_checker->recheck_modified();
   if (!first_restyle)
     restyling_caused_recheck_was_done = true;
   first_restyle = false;
 }
 
+bool is_user_input_pending() {
+  return HIWORD(GetQueueStatus(QS_INPUT)) != 0;
+}
+
+// Yields as soon as there's user input, timer is stopped while speller query is done on worker thread
+void WINAPI misspelling_index_callback() {
+  ACTIVE_VIEW_BLOCK(npp_interface());
+  const auto start = std::chrono::steady_clock::now();
+  while (!is_user_input_pending() && std::chrono::steady_clock::now() - start < background_time_slice) {
+    if (!spell_checker->update_misspelling_index()) {
+      misspelling_index_timer->stop_timer();
+      return;
+    }
+  }
+}
+
+void schedule_misspelling_index_update() {
+  if (misspelling_index_timer)
+    misspelling_index_timer->set_resolution(std::chrono::milliseconds(misspelling_index_timer_resolution));
+}
+
+// Works only when nothing else is pending and yields as soon as there's user input
+void WINAPI prefetch_callback() {
+  if (is_any_timer_active())
+    return;
+
+  ACTIVE_VIEW_BLOCK(npp_interface());
+  const auto start = std::chrono::steady_clock::now();
+  while (!is_user_input_pending() && std::chrono::steady_clock::now() - start < background_time_slice) {
+    if (!spell_checker->prefetch_next_chunk()) {
+      prefetch_timer->stop_timer();
+      return;
+    }
+  }
+}
+
+void schedule_prefetch() {
+  if (prefetch_timer)
+    prefetch_timer->set_resolution(std::chrono::milliseconds(prefetch_timer_resolution));
+}
+
 void WINAPI scroll_recheck_callback() {
   scroll_recheck_timer->stop_timer();
 
@@ -733,6 +784,9 @@ extern "C" __declspec(dllexport) void beNotified(SCNotification *notify_code) {
     print_to_log(L"NPPN_SHUTDOWN", npp->get_editor_hwnd());
     edit_recheck_timer.reset();
     scroll_recheck_timer.reset();
+    misspelling_index_timer.reset();
+    prefetch_timer.reset();
+    spell_checker->cancel_async_checks();
     command_menu_clean_up();
 
     plugin_clean_up();
@@ -750,6 +804,13 @@ extern "C" __declspec(dllexport) void beNotified(SCNotification *notify_code) {
     edit_recheck_timer->on_timer_tick.connect(edit_recheck_callback);
     scroll_recheck_timer.emplace(npp_data.npp_handle);
     scroll_recheck_timer->on_timer_tick.connect(scroll_recheck_callback);
+    misspelling_index_timer.emplace(npp_data.npp_handle);
+    misspelling_index_timer->on_timer_tick.connect(misspelling_index_callback);
+    spell_checker->misspelling_index_outdated.connect(schedule_misspelling_index_update);
+    prefetch_timer.emplace(npp_data.npp_handle);
+    prefetch_timer->on_timer_tick.connect(prefetch_callback);
+    spell_checker->prefetch_scheduled.connect(schedule_prefetch);
+    schedule_misspelling_index_update();
     spell_checker->recheck_visible_both_views();
     restyling_caused_recheck_was_done = false;
     suggestions_button->set_transparency();
@@ -764,9 +825,16 @@ extern "C" __declspec(dllexport) void beNotified(SCNotification *notify_code) {
       return;
     recheck_visible();
     restyling_caused_recheck_was_done = false;
+    schedule_misspelling_index_update();
   }
   break;
 
+  case NPPN_FILEBEFORECLOSE:
+    if (!spell_checker)
+      return;
+    spell_checker->on_document_closed(npp_interface().path_from_buffer_id(notify_code->nmhdr.idFrom));
+    break;
+
   case SCN_FOLDINGSTATECHANGED:
     update_on_visible_area_changed();
     break;
@@ -798,6 +866,19 @@ extern "C" __declspec(dllexport) void beNotified(SCNotification *notify_code) {
   case SCN_MODIFIED:
     if (!spell_checker)
       return;
+    if ((notify_code->modificationType & (SC_MOD_DELETETEXT | SC_MOD_INSERTTEXT | SC_MOD_CHANGESTYLE)) != 0) {
+      ACTIVE_VIEW_BLOCK(npp_interface());
+      // modifications of documents not shown in active view are handled by full recheck on activation
+      if (notify_code->nmhdr.hwndFrom == npp_interface().get_view_hwnd()) {
+        if ((notify_code->modificationType & SC_MOD_INSERTTEXT) != 0)
+          spell_checker->on_text_inserted(notify_code->position, notify_code->length);
+        else if ((notify_code->modificationType & SC_MOD_DELETETEXT) != 0)
+          spell_checker->on_text_deleted(notify_code->position, notify_code->length);
+        else if (edit_recheck_timer && edit_recheck_timer->is_set()) // restyling matters only if partial recheck is pending
+          spell_checker->on_style_changed(notify_code->position, notify_code->length);
+      } else if ((notify_code->modificationType & (SC_MOD_DELETETEXT | SC_MOD_INSERTTEXT)) != 0)
+        spell_checker->on_other_window_modified(notify_code->nmhdr.hwndFrom);
+    }
     if (edit_recheck_timer && (notify_code->modificationType & (SC_MOD_DELETETEXT | SC_MOD_INSERTTEXT)) != 0) {
       edit_recheck_timer->set_resolution(std::chrono::milliseconds(get_settings().data.recheck_delay));
     }
@@ -132,28 +132,53 @@ static const wchar_t *default_language(SpellerId value) {
 Settings::Settings(std::wstring_view ini_filepath)
   : m_ini_filepath(ini_filepath) {
   settings_changed.connect([this] { on_settings_changed(); });
+  update_cached_values();
 }
 
-const std::wregex *Settings::get_ignore_regexp() const {
-  return std::get_if<std::wregex> (&data.ignore_regexp);
+const IgnoreRegexpMatcher *Settings::get_ignore_regexp() const {
+  return std::get_if<IgnoreRegexpMatcher> (&data.ignore_regexp);
 }
 
 const std::regex_error *Settings::get_regexp_error() const {
   return std::get_if<std::regex_error> (&data.ignore_regexp);
 }
 
+const ScintillaUtils::StyleCategoryRow &Settings::get_udl_style_categories() const {
+  return data.udl_style_categories;
+}
+
+const WordFilter &Settings::get_word_filter() const {
+  return data.word_filter;
+}
+
 void Settings::on_settings_changed() {
   update_cached_values();
 }
 
 void Settings::update_cached_values() {
   data.processed_delimiters = L" \n\r\t\v" + parse_string(data.delimiters.c_str());
+  data.delimiter_set = DelimiterSet(data.processed_delimiters);
+  switch (data.tokenization_style) {
+  case TokenizationStyle::by_non_alphabetic:
+    data.char_classes.set_non_alphabetic_delimiters(data.delimiter_exclusions);
+    break;
+  case TokenizationStyle::by_non_ansi:
+    data.char_classes.set_non_ansi_delimiters(data.delimiter_exclusions);
+    break;
+  case TokenizationStyle::by_delimiters:
+    data.char_classes.set_delimiters(data.delimiter_set);
+    break;
+  case TokenizationStyle::COUNT:
+    break;
+  }
   try {
-    data.ignore_regexp = std::wregex (data.ignore_regexp_str);
+    data.ignore_regexp = IgnoreRegexpMatcher (data.ignore_regexp_str);
   }
   catch (const std::regex_error &error) {
     data.ignore_regexp = error;
   }
+  data.udl_style_categories = ScintillaUtils::make_udl_style_categories(data.check_default_udl_style);
+  data.word_filter = WordFilter::compile(*this);
 }
 
 constexpr auto app_name = L"SpellCheck";
@@ -269,6 +294,7 @@ void Settings::process(IniWorker &worker) {
   worker.process(L"Show_Only_Known", data.download_show_only_recognized_dictionaries, false);
   worker.process(L"Install_Dictionaries_For_All_Users", data.download_install_dictionaries_for_all_users, false);
   worker.process(L"Recheck_Delay", data.recheck_delay, 500);
+  worker.process(L"Prefetch_Screen_Count", data.prefetch_screen_count, 2);
   for (int i = 0; i < static_cast<int>(data.server_names.size()); ++i)
     worker.process(wstring_printf(L"Server_Address[%d]", i).c_str(), data.server_names[i], L"");
   worker.process(L"Last_Used_Address_Index", data.last_used_address_index, 0);
@@ -15,10 +15,14 @@
 #pragma once
 
 #include "lsignal.h"
+#include "common/CharClassTable.h"
 #include "common/enum_array.h"
 #include "common/string_utils.h"
 #include "common/TemporaryAcessor.h"
 #include "common/Utility.h"
+#include "core/IgnoreRegexpMatcher.h"
+#include "core/WordFilter.h"
+#include "npp/ScintillaUtils.h"
 #include "spellers/SpellerId.h"
 
 #include <regex>
@@ -84,26 +88,25 @@ public:
   Settings(std::wstring_view ini_filepath = L"");
   Settings(const Settings &) = delete;
   Settings &operator=(const Settings &) = delete;
-  const std::wregex *get_ignore_regexp() const;
+  const IgnoreRegexpMatcher *get_ignore_regexp() const;
   const std::regex_error *get_regexp_error() const;
+  const ScintillaUtils::StyleCategoryRow &get_udl_style_categories() const;
+  const WordFilter &get_word_filter() const;
   Settings(Settings &&) = delete;
   Settings &operator=(Settings &&) = delete;
   void on_settings_changed();
   void update_cached_values();
   void process(IniWorker &worker);
-  auto delimiter_tokenizer(std::wstring_view target) const { return make_delimiter_tokenizer(target, data.processed_delimiters, data.split_camel_case); }
+  auto delimiter_tokenizer(std::wstring_view target) const { return Tokenizer(target, std::cref(data.delimiter_set), data.split_camel_case); }
 
-  auto non_alphabetic_tokenizer(std::wstring_view target) const {
-    return Tokenizer(target, [this](wchar_t c) { return !IsCharAlphaNumeric(c) && data.delimiter_exclusions.find(c) == std::wstring_view::npos; },
-                     data.split_camel_case);
-  }
+  // tokenizer for non-alphabetic and non-ANSI styles, delimiters are taken from the class table
+  auto char_class_tokenizer(std::wstring_view target) const { return Tokenizer(target, std::cref(data.char_classes), data.split_camel_case); }
 
   template <typename FunctionType> auto do_with_tokenizer(std::wstring_view target, const FunctionType &function) const {
     switch (data.tokenization_style) {
     case TokenizationStyle::by_non_alphabetic:
-      return function(this->non_alphabetic_tokenizer(target));
     case TokenizationStyle::by_non_ansi:
-      return function(this->non_ansi_tokenizer(target));
+      return function(this->char_class_tokenizer(target));
     case TokenizationStyle::by_delimiters:
       return function(this->delimiter_tokenizer(target));
     case TokenizationStyle::COUNT:
@@ -112,22 +115,18 @@ public:
     throw std::runtime_error("Incorrect tokenization style");
   }
 
-  auto non_ansi_tokenizer(std::wstring_view target) const {
-    return Tokenizer(target,
-                     [this](wchar_t c) {
-                       static const auto ansi_str = []() {
-                         constexpr auto char_cnt = 256;
-                         std::string s;
-                         for (int i = 1; i < char_cnt; ++i)
-                           s.push_back(static_cast<char>(i));
-                         auto ws = to_wstring(s);
-                         std::erase_if(ws, [](wchar_t c) { return !IsCharAlphaNumeric(c); });
-                         std::sort(ws.begin(), ws.end());
-                         return ws;
-                       }();
-                       return !std::binary_search(ansi_str.begin(), ansi_str.end(), c) && data.delimiter_exclusions.find(c) == std::wstring_view::npos;
-                     },
-                     data.split_camel_case);
+  // Same as do_with_tokenizer but for UTF-8 text
+  template <typename FunctionType> auto do_with_utf8_tokenizer(std::string_view target, const FunctionType &function) const {
+    switch (data.tokenization_style) {
+    case TokenizationStyle::by_non_alphabetic:
+    case TokenizationStyle::by_non_ansi:
+      return function(Utf8Tokenizer(target, std::cref(data.char_classes), data.split_camel_case));
+    case TokenizationStyle::by_delimiters:
+      return function(Utf8Tokenizer(target, std::cref(data.delimiter_set), data.split_camel_case));
+    case TokenizationStyle::COUNT:
+      break;
+    }
+    throw std::runtime_error("Incorrect tokenization style");
   }
 
   void save(SettingsModificationStyle modification_style);
@@ -180,6 +179,8 @@ public:
     bool download_install_dictionaries_for_all_users = false;
     bool ftp_use_passive_mode = true;
     int recheck_delay = 0;
+    // number of screens above and below visible area checked in advance
+    int prefetch_screen_count = 0;
     std::array<std::wstring, 3> server_names;
     int last_used_address_index = 0;
     bool remove_user_dictionaries = false;
@@ -204,7 +205,11 @@ public:
     // Derivatives:
   private:
     std::wstring processed_delimiters;
-    std::variant<std::wregex, std::regex_error> ignore_regexp;
+    DelimiterSet delimiter_set;
+    CharClassTable char_classes;
+    std::variant<IgnoreRegexpMatcher, std::regex_error> ignore_regexp;
+    ScintillaUtils::StyleCategoryRow udl_style_categories{};
+    WordFilter word_filter;
 
     friend class Settings;
   } data;
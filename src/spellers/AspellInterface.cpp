@@ -164,7 +164,7 @@ bool AspellInterface::check_word(const WordForSpeller &word) const {
   }
 
   bool res = false;
-  auto dst_word = to_utf8_string(word.str.c_str());
+  auto dst_word = !word.utf8.empty() ? word.utf8 : to_utf8_string(word.str.c_str());
 
   auto len = static_cast<int>(dst_word.length());
   switch (m_speller_mode) {
@@ -192,6 +192,11 @@ bool AspellInterface::check_word(const WordForSpeller &word) const {
   return res;
 }
 
+bool AspellInterface::accepts_utf8_words() const {
+  // configured with utf-8 encoding on init
+  return true;
+}
+
 bool AspellInterface::init(const wchar_t *path_arg) {
 #ifdef _WIN64
   constexpr auto cur_bitness = 64;
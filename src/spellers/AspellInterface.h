@@ -39,6 +39,7 @@ public:
   std::vector<std::wstring> get_suggestions(const wchar_t *word) const override;
   void add_to_dictionary(const wchar_t *word) override;
   void ignore_all(const wchar_t *word) override;
+  bool accepts_utf8_words() const override;
 
   bool init(const wchar_t *path_arg);
   AspellStatus get_status() const;
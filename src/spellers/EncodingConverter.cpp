@@ -0,0 +1,126 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "EncodingConverter.h"
+
+#include <algorithm>
+#include <cerrno>
+
+namespace {
+struct ThreadConverter {
+  std::string to_encoding;
+  std::string from_encoding;
+  IconvWrapperT handle;
+};
+
+thread_local std::vector<ThreadConverter> thread_converters;
+thread_local std::vector<char> thread_buffer;
+thread_local std::wstring thread_packed_words;
+
+const auto invalid_handle = reinterpret_cast<iconv_t>(-1);
+
+// Converts as much of input as possible growing `output` when needed, stops at invalid input
+bool convert_all(iconv_t handle, const char *&input, size_t &input_left, std::vector<char> &output, size_t &output_length) {
+  while (true) {
+    if (output.size() - output_length < input_left + 16)
+      output.resize(std::max(output.size() * 2, output_length + input_left * 2 + 16));
+    auto out = output.data() + output_length;
+    size_t out_left = output.size() - output_length;
+    const auto res = iconv(handle, &input, &input_left, &out, &out_left);
+    output_length = out - output.data();
+    if (res != static_cast<size_t>(-1))
+      return true;
+    if (errno != E2BIG)
+      return false;
+    output.resize(output.size() * 2);
+  }
+}
+} // namespace
+
+EncodingConverter::EncodingConverter(std::string to_encoding, std::string from_encoding)
+  : m_to_encoding(std::move(to_encoding)), m_from_encoding(std::move(from_encoding)) {
+}
+
+iconv_t EncodingConverter::thread_handle() const {
+  if (m_to_encoding.empty() || m_from_encoding.empty())
+    return invalid_handle;
+  auto it = std::ranges::find_if(thread_converters, [this](const ThreadConverter &converter) {
+    return converter.to_encoding == m_to_encoding && converter.from_encoding == m_from_encoding;
+  });
+  if (it == thread_converters.end()) {
+    thread_converters.push_back({m_to_encoding, m_from_encoding, IconvWrapperT{m_to_encoding.c_str(), m_from_encoding.c_str()}});
+    it = std::prev(thread_converters.end());
+  }
+  // previous conversion could fail in the middle so shift state is reset every time
+  iconv(it->handle.get(), nullptr, nullptr, nullptr, nullptr);
+  return it->handle.get();
+}
+
+std::string_view EncodingConverter::convert_bytes(std::string_view input) const {
+  const auto handle = thread_handle();
+  if (handle == invalid_handle)
+    return {};
+  auto in = input.data();
+  auto in_left = input.length();
+  size_t length = 0;
+  if (!convert_all(handle, in, in_left, thread_buffer, length))
+    return {};
+  return {thread_buffer.data(), length};
+}
+
+ConvertedWords EncodingConverter::convert_words(const std::vector<std::wstring_view> &words) const {
+  ConvertedWords result;
+  auto &packed = thread_packed_words;
+  packed.clear();
+  for (auto word : words) {
+    packed += word;
+    packed += L'\0';
+  }
+
+  const auto handle = thread_handle();
+  size_t length = 0;
+  if (handle != invalid_handle) {
+    const auto packed_bytes = reinterpret_cast<const char *>(packed.data());
+    auto in = packed_bytes;
+    auto in_left = packed.length() * sizeof(wchar_t);
+    while (!convert_all(handle, in, in_left, result.m_buffer, length)) {
+      // word which could not be converted is left empty and conversion continues from the next one
+      length = std::find(std::make_reverse_iterator(result.m_buffer.begin() + length), result.m_buffer.rend(), '\0').base() - result.m_buffer.begin();
+      result.m_buffer.resize(std::max(result.m_buffer.size(), length + 1));
+      result.m_buffer[length++] = '\0';
+      const auto next_word = packed.find(L'\0', (in - packed_bytes) / sizeof(wchar_t)) + 1;
+      in = packed_bytes + next_word * sizeof(wchar_t);
+      in_left = (packed.length() - next_word) * sizeof(wchar_t);
+      iconv(handle, nullptr, nullptr, nullptr, nullptr);
+    }
+  }
+  result.m_buffer.resize(length);
+
+  result.m_bounds.push_back(0);
+  for (size_t i = 0; i < length; ++i)
+    if (result.m_buffer[i] == '\0')
+      result.m_bounds.push_back(i + 1);
+  if (result.m_bounds.size() != words.size() + 1) {
+    // target encoding doesn't keep words separated, falling back to converting them one by one
+    result.m_buffer.clear();
+    result.m_bounds.assign(1, 0);
+    for (auto word : words) {
+      const auto bytes = convert_bytes({reinterpret_cast<const char *>(word.data()), word.length() * sizeof(wchar_t)});
+      result.m_buffer.insert(result.m_buffer.end(), bytes.begin(), bytes.end());
+      result.m_buffer.push_back('\0');
+      result.m_bounds.push_back(result.m_buffer.size());
+    }
+  }
+  return result;
+}
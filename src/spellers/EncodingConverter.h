@@ -0,0 +1,85 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include "iconv.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class IconvWrapperT {
+  static void close_iconv(iconv_t conv) {
+    if (conv != reinterpret_cast<iconv_t>(-1))
+      iconv_close(conv);
+  }
+
+public:
+  template <typename... ArgTypes> IconvWrapperT(ArgTypes &&... args)
+    : m_conv(iconv_open(std::forward<ArgTypes>(args)...), &close_iconv) {
+  }
+
+  iconv_t get() const { return m_conv.get(); }
+
+  IconvWrapperT()
+    : m_conv(nullptr, &close_iconv) {
+  }
+
+  IconvWrapperT(IconvWrapperT &&) = default;
+  IconvWrapperT &operator=(IconvWrapperT &&) = default;
+
+private:
+  std::unique_ptr<void, void (*)(iconv_t)> m_conv;
+};
+
+// Result of converting several words at once, all words share one buffer
+class ConvertedWords {
+public:
+  size_t size() const { return m_bounds.empty() ? 0 : m_bounds.size() - 1; }
+  // Empty if word could not be converted
+  std::string_view operator[](size_t index) const { return {m_buffer.data() + m_bounds[index], m_bounds[index + 1] - m_bounds[index] - 1}; }
+
+private:
+  friend class EncodingConverter;
+  std::vector<char> m_buffer; // every word is followed by '\0'
+  std::vector<size_t> m_bounds;
+};
+
+// Converts text between two encodings, could be used from several threads at once.
+// Each thread opens its own iconv handle on first use and reuses its output buffer afterwards.
+class EncodingConverter {
+public:
+  EncodingConverter() = default;
+  EncodingConverter(std::string to_encoding, std::string from_encoding);
+
+  // Empty string is returned if conversion fails
+  template <typename OutputCharType, typename InputCharType> std::basic_string<OutputCharType> convert(std::basic_string_view<InputCharType> input) const {
+    const auto bytes = convert_bytes({reinterpret_cast<const char *>(input.data()), input.length() * sizeof(InputCharType)});
+    return {reinterpret_cast<const OutputCharType *>(bytes.data()), bytes.length() / sizeof(OutputCharType)};
+  }
+
+  // Converts all words with a single pass of iconv, target encoding should represent '\0' as a single zero byte
+  ConvertedWords convert_words(const std::vector<std::wstring_view> &words) const;
+
+private:
+  iconv_t thread_handle() const;
+  // Result is valid until next conversion on the same thread
+  std::string_view convert_bytes(std::string_view input) const;
+
+private:
+  std::string m_to_encoding;
+  std::string m_from_encoding;
+};
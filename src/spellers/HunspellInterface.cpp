@@ -54,6 +54,16 @@ std::vector<char> read_file_data(const wchar_t *file_path) {
   return res;
 }
 
+// counters are logged when dictionary is unloaded so that cache sizes could be tuned
+void log_usage_statistics(const std::wstring &path, const DicInfo &dic, HWND npp_window) {
+  if (!dic.is_loaded())
+    return;
+  print_to_log(L"Unloading " + path + L": verdict cache " + std::to_wstring(dic.verdict_cache.hit_count()) + L" hits, " +
+                   std::to_wstring(dic.verdict_cache.miss_count()) + L" misses, stem filter rejected " +
+                   std::to_wstring(dic.stem_filter.statistics().rejected_count) + L" words",
+               npp_window);
+}
+
 void update_word_count(const wchar_t *dictionary_path) {
   if (!dictionary_path || !PathFileExists(dictionary_path))
     return;
@@ -118,30 +128,19 @@ static std::vector<std::wstring> list_files(const wchar_t *path, const wchar_t *
   return out;
 }
 
-template <typename OutputCharType, typename InputCharType>
-static std::basic_string<OutputCharType> convert_impl(const IconvWrapperT &conv, std::basic_string_view<InputCharType> input) {
-  static std::vector<char> buf;
-  if constexpr (std::is_same_v<OutputCharType, char>)
-    buf.resize((input.length() + 1) * 6);
-  else
-    buf.resize((input.length() + 1) * sizeof(OutputCharType));
-  if (conv.get() == iconv_t(-1)) {
-    return {};
-  }
-  size_t in_size = (input.length() + 1) * sizeof(InputCharType);
-  size_t out_size = buf.size();
-  char *out_buf = buf.data();
-  auto in_buf = input.data();
-  size_t res = iconv(conv.get(), reinterpret_cast<const char **>(&in_buf), &in_size, &out_buf, &out_size);
-  if (res == static_cast<size_t>(-1)) {
-    return {};
-  }
-  return {reinterpret_cast<OutputCharType *>(buf.data())};
-}
+std::string DicInfo::to_dictionary_encoding(std::wstring_view input) const { return converter.convert<char>(input); }
 
-std::string DicInfo::to_dictionary_encoding(std::wstring_view input) const { return convert_impl<char>(converter, input); }
+ConvertedWords DicInfo::to_dictionary_encoding(const std::vector<std::wstring_view> &words) const { return converter.convert_words(words); }
 
-std::wstring DicInfo::from_dictionary_encoding(std::string_view input) const { return convert_impl<wchar_t>(back_converter, input); }
+std::wstring DicInfo::from_dictionary_encoding(std::string_view input) const { return back_converter.convert<wchar_t>(input); }
+
+bool DicInfo::spell(const std::string &word) const {
+  if (auto verdict = verdict_cache.find(word))
+    return *verdict;
+  const bool result = hunspell->spell(word);
+  verdict_cache.insert(word, result);
+  return result;
+}
 
 HunspellInterface::HunspellInterface(HWND npp_window_arg, const Settings &settings)
   : m_use_one_dic(false), m_settings(settings) {
@@ -163,6 +162,7 @@ void HunspellInterface::update_on_dic_removal(wchar_t *path, bool &need_single_l
       if (speller == &it->second) {
         need_multi_lang_reset = true;
       }
+    log_usage_statistics(it->first, it->second, m_npp_window);
     m_all_hunspells.erase(it);
   }
 }
@@ -223,7 +223,9 @@ DicInfo *HunspellInterface::create_hunspell(const AvailableLangInfo &lang_info)
         // TODO: use some unique_function implementation in TaskWrapper and remove shared_ptr usage here.
         auto new_dic = std::make_shared<DicInfo>();
         new_dic->local_dic_path = dic_dir + L"\\"s + lang_info.name + L".usr";
-        auto new_hunspell = std::make_unique<Hunspell>(aff_buf_ansi.c_str(), dic_buf_ansi.c_str());
+        // user dictionary directory is writable even when the dictionary itself is in the system one
+        auto cache_buf_ansi = to_string((dic_dir + L"\\"s + lang_info.name + L".dic.cache").c_str());
+        auto new_hunspell = std::make_unique<Hunspell>(aff_buf_ansi.c_str(), dic_buf_ansi.c_str(), nullptr, cache_buf_ansi.c_str());
         const char *dic_encoding = new_hunspell->get_dic_encoding();
         if (stricmp(dic_encoding, "Microsoft-cp1251") == 0)
           dic_encoding = "cp1251"; // Queer fix for encoding which isn't being guessed
@@ -231,6 +233,7 @@ DicInfo *HunspellInterface::create_hunspell(const AvailableLangInfo &lang_info)
         // such failures
         new_dic->converter = {dic_encoding, "UCS-2LE"};
         new_dic->back_converter = {"UCS-2LE", dic_encoding};
+        new_dic->is_utf8 = "UTF-8"sv == dic_encoding;
         if (PathFileExists(new_dic->local_dic_path.c_str())) {
           update_word_count(new_dic->local_dic_path.c_str());
           new_hunspell->add_dic(to_string(new_dic->local_dic_path).c_str());
@@ -245,11 +248,22 @@ DicInfo *HunspellInterface::create_hunspell(const AvailableLangInfo &lang_info)
           } else
             new_hunspell->add_dic(to_string(user_dict_path).c_str());
         }
+        // built from the loaded word table, so the cached dictionary isn't parsed again
+        new_dic->stem_filter = StemFilter(aff_path, new_hunspell->get_words(), new_dic->back_converter);
         new_dic->hunspell = std::move(new_hunspell);
         return new_dic;
       },
       [path = lang_info.full_path, this](std::shared_ptr<DicInfo> dic_info) {
-        m_all_hunspells[path] = std::move(*dic_info);
+        if (dic_info->stem_filter.is_enabled()) {
+          const auto stats = dic_info->stem_filter.statistics();
+          print_to_log(L"Stem filter for " + path + L": " + std::to_wstring(stats.stem_count) + L" stems, " + std::to_wstring(stats.memory_usage) +
+                           L" bytes, false positive rate " + std::to_wstring(stats.false_positive_rate),
+                       m_npp_window);
+        }
+        {
+          auto lock = lock_spellers();
+          m_all_hunspells[path] = std::move(*dic_info);
+        }
         speller_loaded();
       });
 
@@ -290,46 +304,76 @@ void HunspellInterface::set_multiple_languages(const std::vector<std::wstring> &
   }
 }
 
-bool HunspellInterface::speller_check_word(const DicInfo &dic, WordForSpeller word) {
-  if (!dic.is_loaded())
-    return true;
-  if (word.data.ends_with_dot)
-    word.str += L".";
-  auto word_to_check = dic.to_dictionary_encoding(word.str.c_str());
-  if (word_to_check.empty())
-    return false;
-  // No additional check for memorized is needed since all words are already in
-  // dictionary
+void HunspellInterface::speller_check_words(const DicInfo &dic, const std::vector<WordForSpeller> &words, std::vector<bool> &results) {
+  std::vector<size_t> indices_to_convert;
+  std::vector<std::wstring_view> words_to_convert;
+  std::vector<std::wstring> words_with_dot;
+  words_with_dot.reserve(words.size());
+  for (size_t i = 0; i < words.size(); ++i) {
+    if (results[i])
+      continue;
+    auto &word = words[i];
+    if (!dic.is_loaded())
+      results[i] = true;
+    else if (!word.data.ends_with_dot && dic.stem_filter.rejects(word.str))
+      continue; // surely misspelled, no need to convert and spell it
+    else if (dic.is_utf8 && !word.utf8.empty() && word.data.ends_with_dot)
+      results[i] = dic.spell(word.utf8 + '.');
+    else if (dic.is_utf8 && !word.utf8.empty())
+      results[i] = dic.spell(word.utf8);
+    else {
+      indices_to_convert.push_back(i);
+      words_to_convert.push_back(word.data.ends_with_dot ? words_with_dot.emplace_back(word.str + L'.') : word.str);
+    }
+  }
+  if (words_to_convert.empty())
+    return;
 
-  return dic.hunspell->spell(word_to_check);
+  const auto converted = dic.to_dictionary_encoding(words_to_convert);
+  std::string word_to_check;
+  for (size_t i = 0; i < indices_to_convert.size(); ++i) {
+    if (converted[i].empty())
+      continue;
+    // No additional check for memorized is needed since all words are already in
+    // dictionary
+    word_to_check.assign(converted[i]);
+    results[indices_to_convert[i]] = dic.spell(word_to_check);
+  }
 }
 
-bool HunspellInterface::check_word(const WordForSpeller &word) const {
-  if (m_ignored.find(word.str) != m_ignored.end())
-    return true;
+std::vector<bool> HunspellInterface::check_words(const std::vector<WordForSpeller> &words) const {
+  std::vector<bool> results(words.size());
+  for (size_t i = 0; i < words.size(); ++i)
+    results[i] = m_ignored.find(words[i].str) != m_ignored.end();
 
-  bool res = false;
   switch (m_speller_mode) {
   case SpellerMode::SingleLanguage: {
     if (m_singular_speller != nullptr)
-      res = speller_check_word(*m_singular_speller, word);
+      speller_check_words(*m_singular_speller, words, results);
     else
-      res = true;
+      results.assign(words.size(), true);
   }
   break;
   case SpellerMode::MultipleLanguages: {
     if (m_spellers.empty())
-      return true;
+      results.assign(words.size(), true);
 
-    for (auto &speller : m_spellers) {
-      res = res || speller_check_word(*speller, word);
-      if (res)
-        break;
-    }
+    for (auto &speller : m_spellers)
+      speller_check_words(*speller, words, results);
   }
   break;
   }
-  return res;
+  return results;
+}
+
+bool HunspellInterface::accepts_utf8_words() const {
+  switch (m_speller_mode) {
+  case SpellerMode::SingleLanguage:
+    return m_singular_speller != nullptr && m_singular_speller->is_utf8;
+  case SpellerMode::MultipleLanguages:
+    return !m_spellers.empty() && std::ranges::all_of(m_spellers, &DicInfo::is_utf8);
+  }
+  return false;
 }
 
 void HunspellInterface::message_box_word_cannot_be_added() {
@@ -347,24 +391,33 @@ HunspellInterface::~HunspellInterface() {
   for (auto &p : m_all_hunspells) {
     auto &hs = p.second;
     update_word_count(hs.local_dic_path.c_str());
+    log_usage_statistics(p.first, hs, m_npp_window);
   }
 }
 
 void HunspellInterface::reset_spellers() {
   // these triggers reload of all hunspells and user dictionaries
+  for (auto &[path, dic] : m_all_hunspells)
+    log_usage_statistics(path, dic, m_npp_window);
   m_all_hunspells.clear();
 }
 
 // drop cache if dictionary was removed
-void HunspellInterface::dictionary_removed(const std::wstring &path) { m_all_hunspells.erase(path); }
+void HunspellInterface::dictionary_removed(const std::wstring &path) {
+  if (auto it = m_all_hunspells.find(path); it != m_all_hunspells.end()) {
+    log_usage_statistics(path, it->second, m_npp_window);
+    m_all_hunspells.erase(it);
+  }
+}
 
 std::wstring HunspellInterface::create_encoded_dict_version(const wchar_t *dict_path, const char *target_encoding) {
   std::ifstream is(dict_path);
   std::string line;
   auto tmp_filename = _wtmpnam(nullptr);
   std::ofstream os(tmp_filename);
+  const EncodingConverter converter{target_encoding, "UTF-8"};
   while (std::getline(is, line)) {
-    auto result = convert_impl<char>(IconvWrapperT{target_encoding, "UTF-8"}, std::string_view(line));
+    auto result = converter.convert<char>(std::string_view(line));
     if (!result.empty())
       os << result << '\n';
   }
@@ -409,9 +462,11 @@ void HunspellInterface::add_to_dictionary(const wchar_t *word) {
     append_word_to_user_dictionary(m_user_dic_path.c_str(), to_utf8_string(word).c_str());
     for (auto &p : m_all_hunspells) {
       auto conv_word = p.second.to_dictionary_encoding(word);
-      if (!conv_word.empty())
+      if (!conv_word.empty()) {
         p.second.hunspell->add(conv_word);
-      else if (p.second.hunspell == m_last_selected_speller->hunspell)
+        p.second.verdict_cache.clear();
+        p.second.stem_filter.add(word);
+      } else if (p.second.hunspell == m_last_selected_speller->hunspell)
         message_box_word_cannot_be_added();
       // Adding word to all currently loaded dictionaries and in memorized list
       // to save it.
@@ -419,9 +474,11 @@ void HunspellInterface::add_to_dictionary(const wchar_t *word) {
   } else {
     auto conv_word = m_last_selected_speller->to_dictionary_encoding(word);
     append_word_to_user_dictionary(m_last_selected_speller->local_dic_path.c_str(), conv_word.c_str());
-    if (!conv_word.empty())
+    if (!conv_word.empty()) {
       m_last_selected_speller->hunspell->add(conv_word);
-    else
+      m_last_selected_speller->verdict_cache.clear();
+      m_last_selected_speller->stem_filter.add(word);
+    } else
       message_box_word_cannot_be_added();
   }
 }
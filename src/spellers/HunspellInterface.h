@@ -14,9 +14,11 @@
 
 #pragma once
 
-#include "iconv.h"
+#include "EncodingConverter.h"
+#include "StemFilter.h"
 #include "lsignal.h"
 #include "SpellerInterface.h"
+#include "common/LruCache.h"
 #include "common/Utility.h"
 #include "common/TaskWrapper.h"
 
@@ -25,40 +27,22 @@ class LanguageInfo;
 class Hunspell;
 class Settings;
 
-class IconvWrapperT {
-  static void close_iconv(iconv_t conv) {
-    if (conv != reinterpret_cast<iconv_t>(-1))
-      iconv_close(conv);
-  }
-
-public:
-  template <typename... ArgTypes> IconvWrapperT(ArgTypes &&... args)
-    : m_conv(iconv_open(std::forward<ArgTypes>(args)...), &close_iconv) {
-  }
-
-  iconv_t get() const { return m_conv.get(); }
-
-  IconvWrapperT()
-    : m_conv(nullptr, &close_iconv) {
-  }
-
-  IconvWrapperT(IconvWrapperT &&) = default;
-  IconvWrapperT &operator=(IconvWrapperT &&) = default;
-
-private:
-  std::unique_ptr<void, void (*)(iconv_t)> m_conv;
-};
-
 class DicInfo {
 public:
   std::unique_ptr<Hunspell> hunspell;
-  IconvWrapperT converter;
-  IconvWrapperT back_converter;
+  EncodingConverter converter;
+  EncodingConverter back_converter;
   std::wstring local_dic_path;
+  bool is_utf8 = false;
   std::string to_dictionary_encoding(std::wstring_view input) const;
+  ConvertedWords to_dictionary_encoding(const std::vector<std::wstring_view> &words) const;
   std::wstring from_dictionary_encoding(std::string_view input) const;
+  // Hunspell::spell for word in dictionary encoding, verdicts are cached until dictionary is modified
+  bool spell(const std::string &word) const;
   std::optional<TaskWrapper> loading_task;
   bool is_loaded() const { return !loading_task; }
+  mutable LruCache<std::string, bool> verdict_cache{16 * 1024};
+  StemFilter stem_filter;
 };
 
 class AvailableLangInfo {
@@ -77,11 +61,12 @@ public:
   std::vector<LanguageInfo> get_language_list() const override;
   void set_language(const wchar_t *lang) override;
   void set_multiple_languages(const std::vector<std::wstring> &list) override; // Languages are from SelectMultipleLanguagesDialog
-  bool check_word(const WordForSpeller &word) const override;                  // Word in Utf-8 or ANSI
+  std::vector<bool> check_words(const std::vector<WordForSpeller> &words) const override;
   bool is_working() const override;
   std::vector<std::wstring> get_suggestions(const wchar_t *word) const override;
   void add_to_dictionary(const wchar_t *word) override;
   void ignore_all(const wchar_t *word) override;
+  bool accepts_utf8_words() const override;
 
   void set_directory(const wchar_t *dir);
   void set_additional_directory(const wchar_t *dir);
@@ -94,7 +79,8 @@ public:
 private:
   static std::wstring create_encoded_dict_version(const wchar_t *dict_path, const char *target_encoding);
   DicInfo *create_hunspell(const AvailableLangInfo &lang_info);
-  static bool speller_check_word(const DicInfo &dic, WordForSpeller word);
+  // Checks words which are not marked as correct in `results` yet
+  static void speller_check_words(const DicInfo &dic, const std::vector<WordForSpeller> &words, std::vector<bool> &results);
   void message_box_word_cannot_be_added();
 
 private:
@@ -80,12 +80,16 @@ void SpellerContainer::init_spellers(const NppData &npp_data) {
 }
 
 void SpellerContainer::on_settings_changed() {
-  init_speller();
+  {
+    auto lock = lock_spellers();
+    init_speller();
+  }
   speller_status_changed();
 }
 
 void SpellerContainer::ignore_word(std::wstring wstr) {
   SpellCheckerHelpers::apply_word_conversions(m_settings, wstr);
+  auto lock = lock_spellers();
   // calling get_suggestions before ignoring the word is a requirement by some spellers currently
   // we're just discarding the result
   static_cast<void>(active_speller().get_suggestions(wstr.c_str()));
@@ -94,6 +98,7 @@ void SpellerContainer::ignore_word(std::wstring wstr) {
 
 void SpellerContainer::add_to_dictionary(std::wstring wstr) {
   SpellCheckerHelpers::apply_word_conversions(m_settings, wstr);
+  auto lock = lock_spellers();
   active_speller().add_to_dictionary(wstr.c_str());
 }
 
@@ -118,7 +123,14 @@ static void set_multiple_languages(std::wstring_view multi_string, SpellerInterf
   speller.set_multiple_languages(multi_lang_list);
 }
 
-SpellerContainer::~SpellerContainer() = default;
+SpellerContainer::~SpellerContainer() {
+  // worker thread could still be finishing its check
+  auto lock = lock_spellers();
+  m_single_speller.reset();
+  m_native_speller.reset();
+  m_hunspell_speller.reset();
+  m_aspell_speller.reset();
+}
 
 void SpellerContainer::apply_settings_to_active_speller() {
   if (m_single_speller)
@@ -158,5 +170,10 @@ void SpellerContainer::init_speller() {
 
 TemporaryAcessor<SpellerContainer::Self> SpellerContainer::modify() const {
   auto non_const_this = const_cast<Self *>(this);
-  return {*non_const_this, [non_const_this]() { non_const_this->speller_status_changed(); }};
+  // shared_ptr since finalizer has to be copyable
+  auto lock = std::make_shared<std::unique_lock<std::recursive_mutex>>(lock_spellers());
+  return {*non_const_this, [non_const_this, lock]() {
+    lock->unlock();
+    non_const_this->speller_status_changed();
+  }};
 }
@@ -53,3 +53,8 @@ void DummySpeller::ignore_all(const wchar_t * /*word*/) {
 }
 
 bool DummySpeller::is_working() const { return false; }
+
+std::unique_lock<std::recursive_mutex> lock_spellers() {
+  static std::recursive_mutex mutex;
+  return std::unique_lock{mutex};
+}
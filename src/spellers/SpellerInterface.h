@@ -13,6 +13,7 @@
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #pragma once
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -26,6 +27,8 @@ public:
 class WordForSpeller {
 public:
   std::wstring str;
+  // same word in UTF-8, filled only for spellers which accept UTF-8 words
+  std::string utf8;
   AdditionalWordData data;
 };
 
@@ -55,6 +58,8 @@ public:
   virtual void add_to_dictionary(const wchar_t *word) = 0;
   virtual void ignore_all(const wchar_t *word) = 0;
   virtual bool is_working() const = 0;
+  // Whether check_word(s) would use WordForSpeller::utf8 instead of converting WordForSpeller::str
+  virtual bool accepts_utf8_words() const { return false; }
 
 protected:
   SpellerMode m_speller_mode = SpellerMode::SingleLanguage;
@@ -74,3 +79,6 @@ public:
   void ignore_all(const wchar_t *word) override;
   bool is_working() const override;
 };
+
+// Spellers are used from worker thread to check visible text, any other use or modification of them should be done under this lock
+std::unique_lock<std::recursive_mutex> lock_spellers();
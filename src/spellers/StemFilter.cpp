@@ -0,0 +1,188 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "StemFilter.h"
+
+#include "EncodingConverter.h"
+#include "common/CharClassTable.h"
+
+#include <fstream>
+
+namespace {
+constexpr double stem_false_positive_rate = 0.01;
+// room for words added to dictionary while it's loaded
+constexpr size_t added_word_reserve = 1024;
+
+std::wstring fold_case(std::wstring_view word) {
+  std::wstring result(word);
+  if (!result.empty())
+    CharLowerBuff(result.data(), static_cast<DWORD>(result.size()));
+  return result;
+}
+
+uint64_t hash_word(std::wstring_view word) {
+  // FNV-1a
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (auto c : word) {
+    hash ^= static_cast<uint16_t>(c);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+std::vector<std::string_view> split_fields(std::string_view line) {
+  std::vector<std::string_view> fields;
+  size_t pos = 0;
+  while (true) {
+    pos = line.find_first_not_of(" \t", pos);
+    if (pos == std::string_view::npos)
+      break;
+    const auto end = std::min(line.find_first_of(" \t", pos), line.length());
+    fields.push_back(line.substr(pos, end - pos));
+    pos = end;
+  }
+  return fields;
+}
+
+bool is_number(std::string_view str) { return !str.empty() && std::ranges::all_of(str, [](char c) { return c >= '0' && c <= '9'; }); }
+
+void remove_line_ending(std::string &line) {
+  if (!line.empty() && line.back() == '\r')
+    line.pop_back();
+}
+} // namespace
+
+StemFilter::StemFilter(const std::wstring &aff_path, const std::vector<std::string> &stems, const EncodingConverter &decoder) {
+  if (!read_affixes(aff_path, decoder))
+    return;
+
+  m_stems = BloomFilter(stems.size() + added_word_reserve, stem_false_positive_rate);
+  insert_stems(stems, decoder);
+  m_enabled = true;
+}
+
+bool StemFilter::read_affixes(const std::wstring &aff_path, const EncodingConverter &decoder) {
+  std::ifstream is(aff_path, std::ios::binary);
+  if (!is)
+    return false;
+  std::string line;
+  bool first_line = true;
+  while (std::getline(is, line)) {
+    remove_line_ending(line);
+    std::string_view line_view = line;
+    if (first_line && line_view.starts_with("\xEF\xBB\xBF"))
+      line_view.remove_prefix(3);
+    first_line = false;
+    const auto fields = split_fields(line_view);
+    if (fields.empty())
+      continue;
+    const auto keyword = fields.front();
+    // words of COMPLEXPREFIXES dictionaries are stored reversed
+    if (keyword.starts_with("COMPOUND") || keyword == "ICONV" || keyword == "IGNORE" || keyword == "CHECKSHARPS" || keyword == "COMPLEXPREFIXES")
+      return false;
+    // special casing rules of these languages are not reproduced by case folding
+    if (keyword == "LANG" && fields.size() > 1 && (fields[1].starts_with("tr") || fields[1].starts_with("az") || fields[1].starts_with("crh")))
+      return false;
+    if (keyword == "BREAK" && fields.size() > 1 && !is_number(fields[1])) {
+      const auto pattern = decoder.convert<wchar_t>(fields[1]);
+      if (pattern.empty() || std::ranges::any_of(pattern, [](wchar_t c) { return CharClassTable::system().is_alpha(c); }))
+        return false;
+    }
+    if ((keyword == "PFX" || keyword == "SFX") && fields.size() >= 4) {
+      const bool is_header = fields.size() == 4 && (fields[2] == "Y" || fields[2] == "N") && is_number(fields[3]);
+      if (is_header)
+        continue;
+      const auto append = fields[3].substr(0, fields[3].find('/'));
+      // affix without appended part could produce any word
+      if (append.empty() || append == "0")
+        return false;
+      auto decoded = decoder.convert<wchar_t>(append);
+      if (decoded.empty())
+        return false;
+      decoded = fold_case(decoded);
+      if (keyword == "PFX") {
+        m_max_prefix_length = std::max(m_max_prefix_length, decoded.length());
+        m_prefixes.insert(std::move(decoded));
+      } else {
+        m_max_suffix_length = std::max(m_max_suffix_length, decoded.length());
+        m_suffixes.insert(std::move(decoded));
+      }
+    }
+  }
+  return true;
+}
+
+void StemFilter::insert_stems(const std::vector<std::string> &stems, const EncodingConverter &decoder) {
+  // stems are decoded and folded all at once, '\n' is the same in all encodings used by dictionaries
+  std::string packed_stems;
+  for (auto &stem : stems) {
+    packed_stems.append(stem);
+    packed_stems += '\n';
+  }
+
+  auto decoded = decoder.convert<wchar_t>(std::string_view(packed_stems));
+  if (decoded.empty() && !packed_stems.empty()) {
+    // some stem is invalid in dictionary encoding, such stems couldn't match any word so they are skipped
+    for (auto &stem : stems) {
+      decoded += decoder.convert<wchar_t>(std::string_view(stem));
+      decoded += L'\n';
+    }
+  }
+  decoded = fold_case(decoded);
+  for (size_t pos = 0; pos < decoded.length();) {
+    const auto end = std::min(decoded.find(L'\n', pos), decoded.length());
+    if (end > pos)
+      m_stems.insert(hash_word(std::wstring_view(decoded).substr(pos, end - pos)));
+    pos = end + 1;
+  }
+}
+
+bool StemFilter::could_have_affix(std::wstring_view folded_word) const {
+  for (size_t length = 1; length <= std::min(m_max_prefix_length, folded_word.length()); ++length)
+    if (m_prefixes.find(folded_word.substr(0, length)) != m_prefixes.end())
+      return true;
+  for (size_t length = 1; length <= std::min(m_max_suffix_length, folded_word.length()); ++length)
+    if (m_suffixes.find(folded_word.substr(folded_word.length() - length)) != m_suffixes.end())
+      return true;
+  return false;
+}
+
+bool StemFilter::rejects(std::wstring_view word) const {
+  if (!m_enabled || word.empty())
+    return false;
+  // numbers, apostrophes, dashes etc. are handled specially by Hunspell
+  if (!std::ranges::all_of(word, [](wchar_t c) { return CharClassTable::system().is_alpha(c); }))
+    return false;
+  const auto folded = fold_case(word);
+  if (m_stems.may_contain(hash_word(folded)) || could_have_affix(folded))
+    return false;
+  ++m_rejected_count;
+  return true;
+}
+
+void StemFilter::add(std::wstring_view word) {
+  if (m_enabled)
+    m_stems.insert(hash_word(fold_case(word)));
+}
+
+StemFilter::Statistics StemFilter::statistics() const {
+  Statistics result;
+  if (!m_enabled)
+    return result;
+  result.stem_count = m_stems.size();
+  result.memory_usage = m_stems.memory_usage();
+  result.false_positive_rate = m_stems.false_positive_rate();
+  result.rejected_count = m_rejected_count;
+  return result;
+}
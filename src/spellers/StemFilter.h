@@ -0,0 +1,69 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#pragma once
+
+#include "common/BloomFilter.h"
+
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+class EncodingConverter;
+
+// Quick conservative check of words against Hunspell dictionary. Word is rejected only if it's surely not
+// among dictionary stems and no affix rule could produce it, all other words need full check.
+class StemFilter {
+public:
+  struct Statistics {
+    size_t stem_count = 0;
+    size_t memory_usage = 0;
+    double false_positive_rate = 1.0;
+    size_t rejected_count = 0;
+  };
+
+  // Filter which doesn't reject anything
+  StemFilter() = default;
+  // Stems are words of already loaded dictionary (Hunspell::get_words), decoder converts them and affix file to UCS-2LE.
+  // Stays disabled if affix file uses features which could accept words in other ways (compounding, input conversion etc.)
+  StemFilter(const std::wstring &aff_path, const std::vector<std::string> &stems, const EncodingConverter &decoder);
+
+  bool is_enabled() const { return m_enabled; }
+  // True only if Hunspell would surely consider word misspelled
+  bool rejects(std::wstring_view word) const;
+  // Word added to dictionary at runtime
+  void add(std::wstring_view word);
+  Statistics statistics() const;
+
+private:
+  struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::wstring_view str) const { return std::hash<std::wstring_view>{}(str); }
+  };
+  using StringSet = std::unordered_set<std::wstring, StringHash, std::equal_to<>>;
+
+  bool read_affixes(const std::wstring &aff_path, const EncodingConverter &decoder);
+  void insert_stems(const std::vector<std::string> &stems, const EncodingConverter &decoder);
+  bool could_have_affix(std::wstring_view folded_word) const;
+
+private:
+  bool m_enabled = false;
+  BloomFilter m_stems;
+  StringSet m_prefixes;
+  StringSet m_suffixes;
+  size_t m_max_prefix_length = 0;
+  size_t m_max_suffix_length = 0;
+  mutable size_t m_rejected_count = 0;
+};
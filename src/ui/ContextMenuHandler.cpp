@@ -145,6 +145,7 @@ void ContextMenuHandler::process_replace_all(WPARAM result) {
     auto suggestion_copy = suggestion;
     to_lower_inplace(suggestion_copy);
     // if lowercase version is incorrect - the word is not a proper name
+    auto lock = lock_spellers();
     if (m_speller_container.active_speller().check_word({suggestion_copy}))
       is_proper_name = false;
   }
@@ -322,8 +323,11 @@ ContextMenuHandler::get_suggestion_menu_items() {
   m_selected_word = m_editor.get_mapped_wstring_range(m_word_under_cursor_pos, m_word_under_cursor_pos + static_cast<TextPosition>(m_word_under_cursor_length));
   SpellCheckerHelpers::apply_word_conversions(m_settings, m_selected_word.str);
 
-  m_last_suggestions = m_speller_container.active_speller().get_suggestions(
-      m_selected_word.str.c_str());
+  {
+    auto lock = lock_spellers();
+    m_last_suggestions = m_speller_container.active_speller().get_suggestions(
+        m_selected_word.str.c_str());
+  }
 
   for (int i = 0; i < static_cast<int>(m_last_suggestions.size()); i++) {
     if (i >= m_settings.data.suggestion_count)
@@ -276,6 +276,7 @@ void DownloadDictionariesDialog::on_zip_file_downloaded() {
           confirmation = false;
           WinApi::delete_file(dic_file_local_path.c_str());
         } else {
+          auto lock = lock_spellers();
           m_speller_container.get_hunspell_speller().dictionary_removed(hunspell_dic_path);
           WinApi::delete_file(hunspell_dic_path.c_str());
         }
@@ -368,6 +369,7 @@ bool DownloadDictionariesDialog::download_github_file(const std::wstring &title,
       --m_supposed_downloaded_count;
       return false;
     }
+    auto lock = lock_spellers();
     m_speller_container.get_hunspell_speller().dictionary_removed(local_name);
   }
 
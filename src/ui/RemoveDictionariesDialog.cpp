@@ -81,13 +81,18 @@ void RemoveDictionariesDialog::remove_selected() {
         bool success = WinApi::delete_file(file_name);
         wcsncpy(file_name + wcslen(file_name) - 4, L".dic", 4);
         success = success && WinApi::delete_file(file_name);
+        if (j == 0)
+          WinApi::delete_file((std::wstring(file_name) + L".cache").c_str());
         if (m_settings.data.remove_user_dictionaries) {
           wcsncpy(file_name + wcslen(file_name) - 4, L".usr", 4);
           WinApi::delete_file(file_name);
         }
         if (success) {
           file_name[wcslen(file_name) - 4] = L'\0';
-          m_speller_container.get_hunspell_speller().update_on_dic_removal(file_name, single_temp, multi_temp);
+          {
+            auto lock = lock_spellers();
+            m_speller_container.get_hunspell_speller().update_on_dic_removal(file_name, single_temp, multi_temp);
+          }
           need_single_reset |= single_temp;
           need_multi_reset |= multi_temp;
           count++;
@@ -0,0 +1,163 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "MockEditorInterface.h"
+#include "MockSpeller.h"
+#include "SciLexer.h"
+#include "TestCommon.h"
+#include "common/LinearRegex.h"
+#include "core/IgnoreRegexpMatcher.h"
+#include "core/SpellChecker.h"
+#include "core/SpellCheckerHelpers.h"
+#include "npp/EditorInterface.h"
+#include "plugin/Settings.h"
+#include "spellers/SpellerContainer.h"
+
+#include <catch.hpp>
+
+// Hidden by default, run with "[!benchmark]" as test spec
+
+namespace {
+std::vector<std::wstring> make_benchmark_words() {
+  std::vector<std::wstring> words;
+  for (int i = 0; i < 1000; ++i) {
+    for (auto word : {L"This", L"is", L"test", L"document", L"WeirdCase", L"ALLCAPS", L"with_underscore", L"digits123",
+                      L"'quoted'", L"немного", L"слов", L"a"})
+      words.emplace_back(word);
+  }
+  return words;
+}
+} // namespace
+
+TEST_CASE("Word filtering", "[!benchmark]") {
+  Settings settings;
+  {
+    auto mut = settings.modify();
+    mut->data.ignore_one_letter = true;
+    mut->data.ignore_all_capital = true;
+    mut->data.ignore_having_underscore = true;
+    mut->data.ignore_starting_or_ending_with_apostrophe = true;
+    mut->data.word_minimum_length = 2;
+  }
+  auto words = make_benchmark_words();
+  EditorStyleSnapshot snapshot;
+  snapshot.lexer = SCLEX_NULL;
+  snapshot.styles.resize(1);
+
+  BENCHMARK("Word filter") {
+    size_t accepted = 0;
+    for (auto &word : words)
+      accepted += settings.get_word_filter().accepts(word) ? 1 : 0;
+    return accepted;
+  };
+
+  BENCHMARK("Whole check with styles") {
+    size_t accepted = 0;
+    for (auto &word : words)
+      accepted += SpellCheckerHelpers::is_word_spell_checking_needed(settings, snapshot, word, 0) ? 1 : 0;
+    return accepted;
+  };
+}
+
+TEST_CASE("Tokenize", "[!benchmark]") {
+  Settings settings;
+  std::wstring text;
+  for (int i = 0; i < 100'000; ++i)
+    text += L"This is test document, with some more words (and \"quotes\") in it; немного слов.\n";
+
+  BENCHMARK("Delimiter tokenizer") {
+    return settings.delimiter_tokenizer(text).get_all_tokens().size();
+  };
+  {
+    auto mut = settings.modify();
+    mut->data.split_camel_case = true;
+  }
+  BENCHMARK("Delimiter tokenizer with camel case") {
+    return settings.delimiter_tokenizer(text).get_all_tokens().size();
+  };
+}
+
+TEST_CASE("Ignore regexp", "[!benchmark]") {
+  auto words = make_benchmark_words();
+  const std::wstring pattern = L"#.*|.*#|[A-Z]{1,5}|\\w+\\d+";
+  const std::wregex std_regex(pattern);
+  const auto linear_regex = LinearRegex::compile(pattern);
+  REQUIRE(linear_regex);
+  const IgnoreRegexpMatcher matcher(pattern);
+
+  BENCHMARK("std::regex_match") {
+    size_t matched = 0;
+    for (auto &word : words)
+      matched += std::regex_match(word, std_regex) ? 1 : 0;
+    return matched;
+  };
+
+  BENCHMARK("Linear regex") {
+    size_t matched = 0;
+    for (auto &word : words)
+      matched += linear_regex->full_match(word) ? 1 : 0;
+    return matched;
+  };
+
+  BENCHMARK("Matcher with cache") {
+    size_t matched = 0;
+    for (auto &word : words)
+      matched += matcher.matches(word) ? 1 : 0;
+    return matched;
+  };
+}
+
+TEST_CASE("Erase all misspellings", "[!benchmark]") {
+  Settings settings;
+  settings.data.speller_language[SpellerId::aspell] = L"English";
+  MockEditorInterface editor;
+  TARGET_VIEW_BLOCK(editor, 0);
+  editor.open_virtual_document(L"test.txt", L"");
+  auto speller = std::make_unique<MockSpeller>(settings);
+  setup_speller(*speller);
+  SpellerContainer sp_container(&settings, std::move(speller));
+  SpellChecker sc(&settings, editor, sp_container);
+
+  // ~10 MB with 100k misspellings
+  std::string text;
+  for (int i = 0; i < 100'000; ++i)
+    text += "This is test document. Please bear with me. This is test document. badword Please bear with me.\n";
+  editor.set_active_document_text_raw(text);
+
+  // undo restores the text for the next run
+  BENCHMARK("Erase and undo") {
+    sc.erase_all_misspellings();
+    editor.undo();
+  };
+}
+
+TEST_CASE("Replace all tokens", "[!benchmark]") {
+  Settings settings;
+  MockEditorInterface editor;
+  TARGET_VIEW_BLOCK(editor, 0);
+  editor.open_virtual_document(L"test.txt", L"");
+
+  std::string text;
+  for (int i = 0; i < 100'000; ++i)
+    text += "This is test document with badword, Badword and some more words.\n";
+  editor.set_active_document_text_raw(text);
+
+  BENCHMARK("Replace and undo") {
+    {
+      UNDO_BLOCK(editor);
+      SpellCheckerHelpers::replace_all_tokens(editor, settings, "badword", L"goodword", false);
+    }
+    editor.undo();
+  };
+}
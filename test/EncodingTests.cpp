@@ -15,12 +15,17 @@
 #include "MockEditorInterface.h"
 #include "MockSpeller.h"
 #include "TestCommon.h"
+#include "common/utf8.h"
 #include "core/SpellChecker.h"
+#include "npp/DocumentTextWindow.h"
+#include "npp/TextUtils.h"
 #include "plugin/Constants.h"
 #include "plugin/Settings.h"
+#include "spellers/EncodingConverter.h"
 #include "spellers/SpellerContainer.h"
 
 #include <catch.hpp>
+#include <random>
 
 TEST_CASE("ANSI") {
   Settings settings;
@@ -66,3 +71,121 @@ TEST_CASE("UTF-8 shenanigans") {
     CHECK(editor.get_next_valid_end_pos(5) == 6);
   }
 }
+
+TEST_CASE("UTF-8 to mapped wstring") {
+  {
+    auto mapped = utf8_to_mapped_wstring("\x80\x80" "abc \xd1\x82\xd0\xb5\xd1\x81\xd1\x82 \xf0\x9f\x98\x80\xff!");
+    CHECK(mapped.str == std::wstring(L"abc тест \0\xFFFD!", 12));
+    CHECK(mapped.mapping == MappedWstring::Mapping{2, 3, 4, 5, 6, 8, 10, 12, 14, 15, 19, 20, 21});
+  }
+  const std::vector<std::string> pieces = {"word ", "0123456789abcdefghijklmnopqrstuvwxyz", "\xd1\x84", "\xe2\x80\x94", "\xf0\x9f\x98\x80", "\xff", "\x80"};
+  std::mt19937 gen(20);
+  std::uniform_int_distribution<size_t> dist(0, pieces.size() - 1);
+  for (int iteration = 0; iteration < 200; ++iteration) {
+    std::string text;
+    for (int i = 0; i < 20; ++i)
+      text += pieces[dist(gen)];
+    auto mapped = utf8_to_mapped_wstring(text);
+    MappedWstring expected;
+    const auto end = text.data() + text.length();
+    const char *it = text.data();
+    while (it != end && utf8_is_cont(*it))
+      ++it;
+    while (it != end) {
+      expected.mapping.push_back(it - text.data());
+      expected.str.push_back(utf8_decode_bmp_char(it, end));
+    }
+    expected.mapping.push_back(it - text.data());
+    REQUIRE(mapped.str == expected.str);
+    REQUIRE(mapped.mapping == expected.mapping);
+  }
+}
+
+TEST_CASE("Sparse mapping") {
+  std::mt19937 gen(21);
+  std::uniform_int_distribution<int> step_dist(1, 3), length_dist(0, 40);
+  for (int iteration = 0; iteration < 100; ++iteration) {
+    std::vector<TextPosition> values;
+    MappedWstring::Mapping mapping;
+    TextPosition value = length_dist(gen);
+    for (int run = 0; run < 10; ++run) {
+      const auto step = step_dist(gen);
+      const auto length = length_dist(gen);
+      if (step == 1)
+        mapping.push_back_run(value, length);
+      for (int i = 0; i < length; ++i, value += step) {
+        values.push_back(value);
+        if (step != 1)
+          mapping.push_back(value);
+      }
+    }
+    const auto size = static_cast<TextPosition>(values.size());
+    REQUIRE(mapping.size() == size);
+    for (TextPosition i = 0; i < size; ++i)
+      REQUIRE(mapping[i] == values[i]);
+    for (TextPosition i = 0; i <= value; ++i)
+      REQUIRE(mapping.lower_bound(i) == std::ranges::lower_bound(values, i) - values.begin());
+    if (size == 0)
+      continue;
+
+    const auto middle = std::uniform_int_distribution<TextPosition>(0, size)(gen);
+    auto part = mapping.subrange(middle, size);
+    for (TextPosition i = middle; i < size; ++i)
+      REQUIRE(part[i - middle] == values[i]);
+    auto joined = mapping.subrange(0, middle);
+    joined.append(part);
+    CHECK(joined == mapping);
+    auto erased = mapping;
+    erased.erase_front(middle);
+    CHECK(erased == part);
+    auto popped = mapping;
+    popped.pop_back();
+    CHECK(popped == mapping.subrange(0, size - 1));
+  }
+}
+
+TEST_CASE("Encoding converter") {
+  const EncodingConverter converter{"cp1251", "UCS-2LE"};
+  const EncodingConverter back_converter{"UCS-2LE", "cp1251"};
+  const std::vector<std::wstring_view> words = {L"слово", L"word", L"中文", L"ещё."};
+  const auto converted = converter.convert_words(words);
+  REQUIRE(converted.size() == words.size());
+  for (size_t i = 0; i < words.size(); ++i)
+    CHECK(converted[i] == converter.convert<char>(words[i]));
+  CHECK(converted[2].empty());
+  CHECK(back_converter.convert<wchar_t>(converted[0]) == L"слово");
+  CHECK(back_converter.convert<wchar_t>(converted[3]) == L"ещё.");
+  CHECK(EncodingConverter{}.convert_words(words)[1].empty());
+}
+
+TEST_CASE("Document text window") {
+  MockEditorInterface editor;
+  TARGET_VIEW_BLOCK(editor, 0);
+  editor.open_virtual_document(L"test.txt", L"тестирование с нетривиальными utf-8 символами");
+  DocumentTextWindow window(editor, 28);
+  CHECK(window.str().empty());
+  // window ends are always moved to character boundaries
+  CHECK(window.extend_right(3));
+  CHECK(window.str() == L"н");
+  CHECK(window.end() == 30);
+  CHECK(window.extend_left(2));
+  CHECK(window.str() == L"с н");
+  CHECK(window.begin() == 25);
+  window.extend_to(57);
+  CHECK(window.str() == L"с нетривиальными ");
+  auto text = window.text(27, 57);
+  auto expected = editor.get_mapped_wstring_range(27, 57);
+  CHECK(text.str == expected.str);
+  CHECK(text.mapping == expected.mapping);
+
+  CHECK(window.take_front(2).str == L"с ");
+  CHECK(window.begin() == 28);
+  CHECK(window.take_back(window.length() - 1).str == L" ");
+  CHECK(window.end() == 56);
+  CHECK(window.str() == L"нетривиальными");
+
+  window.reset(81);
+  CHECK_FALSE(window.extend_right(10));
+  window.reset(0);
+  CHECK_FALSE(window.extend_left(10));
+}
@@ -0,0 +1,148 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "hunspell/hunspell.hxx"
+#include "spellers/EncodingConverter.h"
+#include "spellers/StemFilter.h"
+
+#include <catch.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+std::filesystem::path write_test_file(const wchar_t *name, std::string_view contents) {
+  auto path = std::filesystem::temp_directory_path() / name;
+  std::ofstream(path, std::ios::binary) << contents;
+  return path;
+}
+
+std::string read_test_file(const std::filesystem::path &path) {
+  std::ifstream stream(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+}
+} // namespace
+
+TEST_CASE("Dictionary cache") {
+  const auto aff = write_test_file(L"dspellcheck_test.aff", "SET UTF-8\nAF 2\nAF A\nAF AB\nSFX A Y 1\nSFX A 0 s .\nPFX B Y 1\nPFX B 0 un .\n");
+  const auto dic = write_test_file(L"dspellcheck_test.dic", "4\nword/1\ndo/2\nPlace/1 po:noun\nthing\n");
+  const auto cache = std::filesystem::temp_directory_path() / L"dspellcheck_test.dic.cache";
+  std::filesystem::remove(cache);
+  const std::vector<std::string> words = {"word", "words", "undo", "undos", "Place", "Places", "place", "thing", "things", "unthing", "newword"};
+  auto spelled = [&](bool use_cache) {
+    Hunspell hunspell(aff.string().c_str(), dic.string().c_str(), nullptr, use_cache ? cache.string().c_str() : nullptr);
+    std::vector<bool> result;
+    for (auto &word : words)
+      result.push_back(hunspell.spell(word));
+    return result;
+  };
+  const auto expected = spelled(false);
+  REQUIRE(expected == std::vector{true, true, true, true, true, true, false, true, false, false, false});
+
+  SECTION("Saved and reused") {
+    CHECK(spelled(true) == expected);
+    REQUIRE(std::filesystem::exists(cache));
+    // cache is not written again when it's used
+    const auto old_time = std::filesystem::last_write_time(cache) - std::chrono::hours(1);
+    std::filesystem::last_write_time(cache, old_time);
+    CHECK(spelled(true) == expected);
+    CHECK(std::filesystem::last_write_time(cache) == old_time);
+  }
+  SECTION("Truncated") {
+    spelled(true);
+    const auto contents = read_test_file(cache);
+    std::filesystem::resize_file(cache, contents.size() / 2);
+    CHECK(spelled(true) == expected);
+    // written again after parsing the dictionary
+    CHECK(read_test_file(cache) == contents);
+  }
+  SECTION("Stale") {
+    spelled(true);
+    write_test_file(L"dspellcheck_test.dic", "5\nword/1\ndo/2\nPlace/1 po:noun\nthing/1\nnewword\n");
+    auto changed = expected;
+    changed[8] = true;
+    changed[10] = true;
+    CHECK(spelled(false) == changed);
+    CHECK(spelled(true) == changed);
+  }
+  SECTION("Corrupted") {
+    spelled(true);
+    const auto contents = read_test_file(cache);
+    // damaged caches are either rejected or loaded as some valid table, but never crash
+    for (size_t i = 0; i < contents.size(); ++i) {
+      for (char value : {'\x00', '\x01', '\x02', '\xff'}) {
+        auto damaged = contents;
+        damaged[i] = value;
+        write_test_file(L"dspellcheck_test.dic.cache", damaged);
+        CHECK(spelled(true).size() == words.size());
+      }
+    }
+    std::filesystem::remove(cache);
+    CHECK(spelled(true) == expected);
+  }
+
+  std::filesystem::remove(aff);
+  std::filesystem::remove(dic);
+  std::filesystem::remove(cache);
+}
+
+TEST_CASE("Stem filter") {
+  const std::string affixes = "SET UTF-8\nSFX A Y 1\nSFX A 0 s .\nPFX B Y 1\nPFX B 0 un .\n";
+  const auto aff = write_test_file(L"dspellcheck_stems.aff", affixes);
+  const auto dic = write_test_file(L"dspellcheck_stems.dic", "3\nword/A\ndo/B\nÉcole po:noun\n");
+  Hunspell hunspell(aff.string().c_str(), dic.string().c_str());
+  const EncodingConverter decoder{"UCS-2LE", "UTF-8"};
+
+  SECTION("Words of dictionary") {
+    StemFilter filter(aff.wstring(), hunspell.get_words(), decoder);
+    REQUIRE(filter.is_enabled());
+    CHECK(filter.statistics().stem_count == 3);
+    for (auto word : {L"word", L"do", L"École"})
+      CHECK_FALSE(filter.rejects(word));
+    // affixed forms are left for Hunspell
+    for (auto word : {L"words", L"undo", L"unword"})
+      CHECK_FALSE(filter.rejects(word));
+    for (auto word : {L"WORD", L"Word", L"wOrDs", L"ÉCOLE", L"école"})
+      CHECK_FALSE(filter.rejects(word));
+    // numbers and punctuation are handled by Hunspell itself
+    for (auto word : {L"word1", L"do-do", L""})
+      CHECK_FALSE(filter.rejects(word));
+    for (auto word : {L"wordy", L"xyzzy", L"Ecole", L"WORDZ"})
+      CHECK(filter.rejects(word));
+    CHECK(filter.statistics().rejected_count == 4);
+  }
+  SECTION("Words added at runtime") {
+    StemFilter filter(aff.wstring(), hunspell.get_words(), decoder);
+    CHECK(filter.rejects(L"newword"));
+    filter.add(L"NewWord");
+    CHECK_FALSE(filter.rejects(L"newword"));
+    CHECK_FALSE(filter.rejects(L"NEWWORD"));
+    hunspell.add("added");
+    CHECK_FALSE(StemFilter(aff.wstring(), hunspell.get_words(), decoder).rejects(L"added"));
+  }
+  SECTION("Disabled by affix file") {
+    for (auto feature : {"COMPOUNDFLAG X\n", "COMPOUNDMIN 3\n", "ICONV 1\nICONV a b\n", "IGNORE x\n", "COMPLEXPREFIXES\n", "SFX C Y 1\nSFX C 0 0 .\n"}) {
+      write_test_file(L"dspellcheck_stems.aff", affixes + feature);
+      StemFilter filter(aff.wstring(), hunspell.get_words(), decoder);
+      CHECK_FALSE(filter.is_enabled());
+      CHECK_FALSE(filter.rejects(L"xyzzy"));
+    }
+  }
+  SECTION("Disabled by default") {
+    CHECK_FALSE(StemFilter().rejects(L"xyzzy"));
+  }
+
+  std::filesystem::remove(aff);
+  std::filesystem::remove(dic);
+}
@@ -18,6 +18,7 @@
 #include "SciLexer.h"
 #include "TestCommon.h"
 #include "core/SpellChecker.h"
+#include "npp/ScintillaUtils.h"
 #include "plugin/Constants.h"
 #include "plugin/Settings.h"
 #include "spellers/SpellerContainer.h"
@@ -97,5 +98,26 @@ TEST_CASE("Language Styles") {
     editor.indicator_fill_range(0, editor.get_active_document_length());
     sc.recheck_visible_both_views();
     CHECK(editor.get_underlined_words(spell_check_indicator_id).empty());
+
+    editor.set_active_document_text(L"abcdef badword abcdef");
+    editor.set_whole_text_style(SCE_POWERSHELL_COMMENTSTREAM);
+    editor.set_current_indicator(URL_INDIC);
+    editor.indicator_clear_range(0, editor.get_active_document_length());
+    editor.indicator_fill_range(7, 14);
+    sc.recheck_visible_both_views();
+    CHECK(editor.get_underlined_words(spell_check_indicator_id) == std::vector<std::string>{"abcdef", "abcdef"});
+  }
+}
+
+TEST_CASE("Style category table") {
+  for (auto check_default_udl_style : {false, true}) {
+    Settings settings;
+    settings.data.check_default_udl_style = check_default_udl_style;
+    settings.update_cached_values();
+    for (LRESULT lexer = 0; lexer <= SCLEX_USER; ++lexer)
+      for (LRESULT style = 0; style < ScintillaUtils::style_count; ++style)
+        REQUIRE(ScintillaUtils::get_style_category(lexer, style, settings) ==
+                ScintillaUtils::evaluate_style_category(lexer, style, check_default_udl_style));
+    CHECK(ScintillaUtils::get_style_category(SCLEX_AUTOMATIC, 0, settings) == ScintillaUtils::StyleCategory::unknown);
   }
 }
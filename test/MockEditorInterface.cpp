@@ -113,6 +113,7 @@ void MockEditorInterface::set_indicator_foreground(
 
 void MockEditorInterface::set_current_indicator(
     int indicator_index) {
+  ++m_message_count;
   auto doc = active_document();
   if (!doc)
     return;
@@ -123,6 +124,7 @@ void MockEditorInterface::set_current_indicator(
 
 void MockEditorInterface::indicator_fill_range(TextPosition from,
                                                TextPosition to) {
+  ++m_message_count;
   auto doc = active_document();
   if (!doc)
     return;
@@ -134,6 +136,7 @@ void MockEditorInterface::indicator_fill_range(TextPosition from,
 
 void MockEditorInterface::indicator_clear_range(TextPosition from,
                                                 TextPosition to) {
+  ++m_message_count;
   auto doc = active_document();
   if (!doc)
     return;
@@ -144,8 +147,9 @@ void MockEditorInterface::indicator_clear_range(TextPosition from,
 }
 
 int MockEditorInterface::get_indicator_value_at(int indicator_id, TextPosition position) const {
+  ++m_message_count;
   auto doc = active_document();
-  if (!doc)
+  if (!doc || indicator_id >= static_cast<int>(doc->indicator_info.size()))
     return FALSE;
   auto &s = doc->indicator_info[indicator_id].set_for;
   if (position >= static_cast<TextPosition>(s.size()) || position < 0)
@@ -153,6 +157,24 @@ int MockEditorInterface::get_indicator_value_at(int indicator_id, TextPosition p
   return s[position];
 }
 
+TextPosition MockEditorInterface::get_indicator_end(int indicator_id, TextPosition position) const {
+  ++m_message_count;
+  auto doc = active_document();
+  if (!doc)
+    return position;
+  auto length = get_active_document_length();
+  auto value_at = [&](TextPosition pos) {
+    if (indicator_id >= static_cast<int>(doc->indicator_info.size()))
+      return false;
+    auto &s = doc->indicator_info[indicator_id].set_for;
+    return pos >= 0 && pos < static_cast<TextPosition>(s.size()) && s[pos];
+  };
+  auto value = value_at(position);
+  while (position < length && value_at(position) == value)
+    ++position;
+  return position;
+}
+
 int MockEditorInterface::active_view() const {
   return static_cast<int>(m_active_view);
 }
@@ -210,6 +232,14 @@ TextPosition MockEditorInterface::get_line_start_position(
   return static_cast<TextPosition>(index);
 }
 
+TextPosition MockEditorInterface::get_next_marked_line(TextPosition line) const {
+  auto doc = active_document();
+  if (!doc)
+    return -1;
+  auto it = doc->cur.bookmarked_lines.lower_bound(static_cast<size_t>(line));
+  return it != doc->cur.bookmarked_lines.end() ? static_cast<TextPosition>(*it) : -1;
+}
+
 TextPosition MockEditorInterface::get_line_end_position(
     TextPosition line) const {
   auto doc = active_document();
@@ -249,12 +279,21 @@ TextPosition MockEditorInterface::get_selection_end() const {
 
 int MockEditorInterface::get_style_at(
     TextPosition position) const {
+  ++m_message_count;
   auto doc = active_document();
   if (!doc)
     return -1;
   return doc->cur.style[position];
 }
 
+std::vector<int> MockEditorInterface::get_styles(TextPosition from, TextPosition to) const {
+  ++m_message_count;
+  auto doc = active_document();
+  if (!doc)
+    return {};
+  return {doc->cur.style.begin() + from, doc->cur.style.begin() + to};
+}
+
 TextPosition MockEditorInterface::get_active_document_length(
     ) const {
   auto doc = active_document();
@@ -434,7 +473,16 @@ HWND MockEditorInterface::get_editor_hwnd() const {
 }
 
 HWND MockEditorInterface::get_view_hwnd() const {
-  return nullptr;
+  // fake handles, only to tell views apart
+  return reinterpret_cast<HWND>(static_cast<intptr_t>(m_target_view + 1));
+}
+
+bool MockEditorInterface::shows_same_document(HWND window) const {
+  auto view = static_cast<int>(reinterpret_cast<intptr_t>(window)) - 1;
+  if (view < 0 || view >= view_count || m_documents[view].empty())
+    return false;
+  auto doc = active_document();
+  return doc && doc->path == m_documents[view][m_active_document_index[view]].path;
 }
 
 std::wstring MockEditorInterface::get_full_current_path() const {
@@ -446,6 +494,7 @@ std::wstring MockEditorInterface::get_full_current_path() const {
 
 std::string MockEditorInterface::get_text_range(TextPosition from,
                                                 TextPosition to) const {
+  ++m_message_count;
   auto doc = active_document();
   if (!doc)
     return "";
@@ -512,6 +561,14 @@ void MockEditorInterface::open_virtual_document(
       static_cast<int>(m_documents[m_target_view].size() - 1);
 }
 
+void MockEditorInterface::close_active_document() {
+  auto &documents = m_documents[m_target_view];
+  if (documents.empty())
+    return;
+  documents.erase(documents.begin() + m_active_document_index[m_target_view]);
+  m_active_document_index[m_target_view] = static_cast<int>(documents.size()) - 1;
+}
+
 void MockEditorInterface::set_active_document_text(
     const std::wstring &text) {
   auto doc = active_document();
@@ -636,7 +693,17 @@ void MockEditorInterface::replace_text(TextPosition from, TextPosition to, std::
   auto doc = active_document();
   if (!doc)
     return;
+  if (m_save_undo[m_target_view])
+    doc->save_state();
   auto &d = doc->cur.data;
+  // like Scintilla, markers of removed lines are merged into the first line of the range
+  const auto first_line = static_cast<size_t>(std::count(d.begin(), d.begin() + from, '\n'));
+  const auto removed_lines = static_cast<size_t>(std::count(d.begin() + from, d.begin() + to, '\n'));
+  const auto added_lines = static_cast<size_t>(std::count(replacement.begin(), replacement.end(), '\n'));
+  std::set<size_t> bookmarked_lines;
+  for (auto line : doc->cur.bookmarked_lines)
+    bookmarked_lines.insert(line <= first_line ? line : line <= first_line + removed_lines ? first_line : line + added_lines - removed_lines);
+  doc->cur.bookmarked_lines = std::move(bookmarked_lines);
   d.replace(from, to - from, replacement);
   doc->cur.style.resize(doc->cur.data.length());
 }
@@ -668,6 +735,10 @@ int MockEditorInterface::get_view_count() const {
   return mock_editor_view_count;
 }
 
+size_t MockEditorInterface::get_message_count() const {
+  return m_message_count;
+}
+
 void MockEditorInterface::clear_indicator_info() {
   auto doc = active_document();
   if (!doc)
@@ -68,6 +68,8 @@ public:
   void indicator_fill_range(TextPosition from, TextPosition to) override;
   void indicator_clear_range(TextPosition from, TextPosition to) override;
   int get_indicator_value_at(int indicator_id, TextPosition position) const override;
+  TextPosition get_indicator_end(int indicator_id, TextPosition position) const override;
+  std::vector<int> get_styles(TextPosition from, TextPosition to) const override;
   EditorCodepage get_encoding() const override;
   TextPosition get_current_pos() const override;
   int get_current_line_number() const override;
@@ -75,6 +77,7 @@ public:
   int line_from_position(TextPosition position) const override;
   TextPosition get_line_start_position(TextPosition line) const override;
   TextPosition get_line_end_position(TextPosition line) const override;
+  TextPosition get_next_marked_line(TextPosition line) const override;
   int get_lexer() const override;
   TextPosition get_selection_start() const override;
   TextPosition get_selection_end() const override;
@@ -105,6 +108,7 @@ public:
                                                               int y) const override;
   HWND get_editor_hwnd() const override;
   HWND get_view_hwnd() const override;
+  bool shows_same_document(HWND window) const override;
   std::wstring get_full_current_path() const override;
   std::string get_text_range(TextPosition from,
                              TextPosition to) const override;
@@ -116,6 +120,7 @@ public:
   ~MockEditorInterface();
   void open_virtual_document(const std::wstring &path,
                              const std::wstring &data);
+  void close_active_document();
   void set_active_document_text(const std::wstring &text);
   void set_active_document_text_raw(const std::string &text);
   std::vector<std::string> get_underlined_words(int indicator_id) const;
@@ -136,6 +141,8 @@ public:
   std::set<size_t> get_bookmarked_lines() const;
   int get_view_count() const override;
   void clear_indicator_info();
+  // number of text, style and indicator calls (queries and changes) since creation, each being a message to Scintilla
+  size_t get_message_count() const;
   std::vector<std::wstring> get_open_filenames() const override;
   std::vector<std::wstring> get_open_filenames_all_views() const override;
   void set_editor_rect(int left, int top, int right, int bottom);
@@ -165,4 +172,5 @@ private:
   RECT m_editor_rect;
   std::optional<POINT> m_cursor_pos;
   int m_first_visible_column = 0;
+  mutable size_t m_message_count = 0;
 };
@@ -14,6 +14,7 @@
 
 #include "MockSpeller.h"
 
+#include "common/Utility.h"
 #include "plugin/Settings.h"
 #include "spellers/LanguageInfo.h"
 
@@ -89,6 +90,15 @@ void MockSpeller::set_suggestions_dict(const SuggestionsDict &dict) {
 }
 
 bool MockSpeller::check_word(const WordForSpeller &word) const {
+  ++m_checked_word_count;
+  if (!word.utf8.empty()) {
+    ++m_checked_utf8_word_count;
+    auto decoded = word;
+    decoded.str = utf8_to_wstring(word.utf8.c_str());
+    decoded.utf8.clear();
+    --m_checked_word_count;
+    return check_word(decoded);
+  }
   switch (m_speller_mode) {
   case SpellerMode::SingleLanguage: {
     auto it = m_inner_dict.find(m_current_lang);
@@ -113,6 +123,14 @@ bool MockSpeller::check_word(const WordForSpeller &word) const {
 
 void MockSpeller::set_working(bool working) { m_working = working; }
 
+size_t MockSpeller::checked_word_count() const { return m_checked_word_count; }
+
+bool MockSpeller::accepts_utf8_words() const { return m_accepts_utf8_words; }
+
+void MockSpeller::set_accepts_utf8_words(bool value) { m_accepts_utf8_words = value; }
+
+size_t MockSpeller::checked_utf8_word_count() const { return m_checked_utf8_word_count; }
+
 std::vector<bool> MockSpeller::check_words(const std::vector<WordForSpeller> &words) const {
   auto res = parent_t::check_words(words);
   if (std::ranges::all_of(res, std::identity{}))
@@ -44,6 +44,12 @@ public:
 
   bool check_word(const WordForSpeller &word) const override;
   void set_working(bool working);
+  // number of words which went through check_word since creation
+  size_t checked_word_count() const;
+  bool accepts_utf8_words() const override;
+  void set_accepts_utf8_words(bool value);
+  // number of checked words which were passed in UTF-8
+  size_t checked_utf8_word_count() const;
 
   std::vector<bool> check_words(const std::vector<WordForSpeller> &words) const override;
 private:
@@ -54,5 +60,8 @@ private:
   Dict m_inner_dict;
   SuggestionsDict m_sugg_dict;
   bool m_working = true;
+  mutable size_t m_checked_word_count = 0;
+  bool m_accepts_utf8_words = false;
+  mutable size_t m_checked_utf8_word_count = 0;
   const Settings &m_settings;
 };
@@ -0,0 +1,72 @@
+// This file is part of DSpellCheck Plug-in for Notepad++
+// Copyright (C)2019 Sergey Semushin <Predelnik@gmail.com>
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+#include "common/LinearRegex.h"
+#include "common/Utility.h"
+#include "core/IgnoreRegexpMatcher.h"
+
+#include <catch.hpp>
+
+namespace {
+void check_same_as_std_regex(const std::wstring &pattern, const std::vector<std::wstring> &strings) {
+  INFO(to_utf8_string(pattern));
+  auto regex = LinearRegex::compile(pattern);
+  REQUIRE(regex);
+  const std::wregex std_regex(pattern);
+  for (auto &str : strings) {
+    INFO(to_utf8_string(str));
+    CHECK(regex->full_match(str) == std::regex_match(str, std_regex));
+  }
+}
+} // namespace
+
+TEST_CASE("Linear regex") {
+  const std::vector<std::wstring> strings = {L"",      L"A",    L"ABBA", L"ALEXANDER", L"abba", L"#x",   L"x#",
+                                             L"123",   L"12a",  L"ab",   L"aab",       L"abab", L"aaab", L"b",
+                                             L"xyxz",  L"xz",   L"z",    L"word-x",    L"was_", L"абв",  L"а",
+                                             L"xxy",   L"y",    L".",    L"_",         L"abc",  L"cab",  L"Ab9",
+                                             L"\n",    L"\r",   L"a\nb", L"\u2028",    L"\u2029"};
+  for (auto pattern : {L"[A-Z]{1,5}", L"#.*|.*#|[A-Z]{1,5}", L"\\d+", L"[^a-z]*", L"(ab|a)*b?", L"a{2,}", L"a{0,3}b",
+                       L"(?:x|y)+z?", L"^ab$", L"[\\w-]+", L"[[:alpha:]]+", L"\\u0430.+", L"a|", L"(a*)*", L"[a\\-z]",
+                       L"x*?y", L".", L"\\.", L"(a|b|c){3}", L"[^\\W_]+", L"\\x41\\x42BA"})
+    check_same_as_std_regex(pattern, strings);
+
+  SECTION("Unsupported syntax") {
+    for (auto pattern : {L"(a)\\1", L"(?=a)a", L"(?!a)b", L"\\bx", L"[]a]", L"]"})
+      CHECK_FALSE(LinearRegex::compile(pattern));
+  }
+  SECTION("Linear time") {
+    auto regex = LinearRegex::compile(L"(a|aa)*b");
+    REQUIRE(regex);
+    CHECK_FALSE(regex->full_match(std::wstring(10000, L'a')));
+    CHECK(regex->full_match(std::wstring(10000, L'a') + L'b'));
+  }
+}
+
+TEST_CASE("Ignore regexp matcher") {
+  CHECK_FALSE(IgnoreRegexpMatcher().matches(L"word"));
+  CHECK_FALSE(IgnoreRegexpMatcher(L"").matches(L"word"));
+  CHECK_THROWS_AS(IgnoreRegexpMatcher(L"[a-"), std::regex_error);
+
+  IgnoreRegexpMatcher matcher(L"[A-Z]{1,5}");
+  CHECK_FALSE(matcher.uses_fallback());
+  CHECK(matcher.matches(L"ABBA"));
+  CHECK(matcher.matches(L"ABBA"));
+  CHECK_FALSE(matcher.matches(L"ALEXANDER"));
+
+  IgnoreRegexpMatcher fallback_matcher(L"(a|b)\\1");
+  CHECK(fallback_matcher.uses_fallback());
+  CHECK(fallback_matcher.matches(L"aa"));
+  CHECK_FALSE(fallback_matcher.matches(L"ab"));
+}
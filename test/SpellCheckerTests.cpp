@@ -14,6 +14,8 @@
 
 #include "MockEditorInterface.h"
 #include "MockSpeller.h"
+#include "PluginInterface.h"
+#include "SciLexer.h"
 #include "TestCommon.h"
 #include "core/SpellChecker.h"
 #include "core/SpellCheckerHelpers.h"
@@ -100,6 +102,23 @@ This is test document
 нехорошееслово
 И ещё немного слов
 ошибочноеслово)");
+    {
+      std::string text;
+      std::string expected;
+      for (int i = 0; i < 500; ++i) {
+        text += "This badword is test wrongword\n";
+        expected += "This  is test \n";
+      }
+      editor.set_active_document_text_raw(text);
+      editor.add_bookmark(10);
+      editor.add_bookmark(250);
+      sc.erase_all_misspellings();
+      CHECK(editor.get_active_document_text() == expected);
+      // lots of edits are merged, but not over bookmarked lines
+      CHECK(editor.get_bookmarked_lines() == std::set<size_t>{10, 250});
+      editor.undo();
+      CHECK(editor.get_active_document_text() == text);
+    }
     editor.set_active_document_text(LR"(
 wrongword
 This is test document
@@ -366,6 +385,18 @@ test_test
     CHECK(editor.get_active_document_text() == "bar bar bar nottoken bar bar");
     SpellCheckerHelpers::replace_all_tokens(editor, settings, "bar", L"foobuzz", false);
     CHECK(editor.get_active_document_text() == "foobuzz foobuzz foobuzz nottoken foobuzz foobuzz");
+    {
+      std::string text;
+      std::string expected;
+      for (int i = 0; i < 200; ++i) {
+        text += "token bar Token ";
+        expected += "foobar bar Foobar ";
+      }
+      editor.set_active_document_text_raw(text);
+      editor.set_cursor_pos(static_cast<TextPosition>(text.length() / 2));
+      SpellCheckerHelpers::replace_all_tokens(editor, settings, "token", L"foobar", false);
+      CHECK(editor.get_active_document_text() == expected);
+    }
     {
       auto m = settings.modify();
       m->data.split_camel_case = true;
@@ -497,6 +528,411 @@ test_test
     sc.recheck_visible_both_views();
     CHECK (editor.get_underlined_words(indicator_id) == std::vector{"donotignore"s, "ALEXANDER"s, "abba"s});
   }
+  SECTION("Verdict cache") {
+    editor.set_active_document_text(L"test document wrongword test document wrongword");
+    editor.make_all_visible();
+    sc.recheck_visible_both_views();
+    CHECK(editor.get_underlined_words(indicator_id) == std::vector{"wrongword"s, "wrongword"s});
+    auto checked_count = speller_ptr->checked_word_count();
+    sc.recheck_visible_both_views();
+    CHECK(speller_ptr->checked_word_count() == checked_count);
+    sp_container.modify()->add_to_dictionary(L"wrongword");
+    CHECK(speller_ptr->checked_word_count() > checked_count);
+    checked_count = speller_ptr->checked_word_count();
+    {
+      auto mut = settings.modify();
+      mut->data.speller_language[SpellerId::aspell] = L"Russian";
+    }
+    CHECK(speller_ptr->checked_word_count() > checked_count);
+    // mock considers all words correct for unknown language, stale verdicts would keep underline
+    CHECK(editor.get_underlined_words(indicator_id).empty());
+  }
+  SECTION("Recheck modified") {
+    editor.set_active_document_text(L"wrongword\nThis is test document\nThis is test document");
+    editor.make_all_visible();
+    sc.recheck_visible_both_views();
+    CHECK(editor.get_underlined_words(indicator_id) == std::vector{"wrongword"s});
+    auto pos = static_cast<TextPosition>(editor.get_active_document_text().rfind("test"));
+    editor.replace_text(pos, pos + 4, "tset");
+    sc.on_text_deleted(pos, 4);
+    sc.on_text_inserted(pos, 4);
+    editor.clear_indicator_info();
+    sc.recheck_modified();
+    // only modified line is rechecked
+    CHECK(editor.get_underlined_words(indicator_id) == std::vector{"tset"s});
+    // nothing is recorded after recheck, so whole visible area is processed
+    sc.recheck_modified();
+    CHECK(editor.get_underlined_words(indicator_id) == std::vector{"wrongword"s, "tset"s});
+  }
+  SECTION("Minimal indicator changes") {
+    editor.set_active_document_text(L"wrongword test badword\nThis is test document\nabirvalg test");
+    editor.make_all_visible();
+    sc.recheck_visible_both_views();
+    CHECK(editor.get_underlined_words(indicator_id) == std::vector{"wrongword"s, "badword"s, "abirvalg"s});
+    auto recheck_message_count = [&] {
+      auto message_count = editor.get_message_count();
+      sc.recheck_visible_both_views();
+      return editor.get_message_count() - message_count;
+    };
+    // repeated recheck only reads text, styles and underlines
+    auto unchanged_count = recheck_message_count();
+    CHECK(recheck_message_count() == unchanged_count);
+    auto pos = static_cast<TextPosition>(editor.get_active_document_text().find("badword"));
+    editor.replace_text(pos, pos + 7, "test me");
+    // the same reads plus setting current indicator and clearing single word
+    CHECK(recheck_message_count() == unchanged_count + 2);
+    // one underline less to read
+    CHECK(recheck_message_count() < unchanged_count);
+    CHECK(editor.get_underlined_words(indicator_id) == std::vector{"wrongword"s, "abirvalg"s});
+  }
+  SECTION("Same document in both views") {
+    std::wstring text;
+    for (int i = 0; i < 40; ++i)
+      text += i == 5 ? L"wrongword\n" : i == 25 ? L"badword\n" : L"This is test document\n";
+    editor.set_active_document_text(text);
+    editor.set_visible_lines(0, 9);
+    {
+      TARGET_VIEW_BLOCK(editor, 1);
+      editor.open_virtual_document(L"test.txt", text);
+      editor.set_visible_lines(20, 29);
+    }
+    sc.recheck_visible_both_views();
+    // views showing the same document share its underlines, visible text of both is checked at once
+    CHECK(editor.get_underlined_words(indicator_id) == std::vector{"wrongword"s, "badword"s});
+
+    // screens around both views are prefetched
+    text.clear();
+    for (int i = 0; i < 200; ++i)
+      text += i == 15 ? L"wrongword\n" : i == 95 ? L"badword\n" : i == 115 ? L"adadsd\n" : i == 150 ? L"abirvalg\n" : L"This is test document\n";
+    editor.set_active_document_text(text);
+    {
+      TARGET_VIEW_BLOCK(editor, 1);
+      editor.set_active_document_text(text);
+      editor.set_visible_lines(100, 109);
+    }
+    settings.modify()->data.prefetch_screen_count = 1;
+    sc.recheck_visible_both_views();
+    while (sc.prefetch_next_chunk()) {
+    }
+    CHECK(editor.get_underlined_words(indicator_id) == std::vector{"wrongword"s, "badword"s, "adadsd"s});
+  }
+  SECTION("Prefetch") {
+    std::wstring text;
+    for (int i = 0; i < 100; ++i) {
+      switch (i) {
+      case 15: text += L"abirvalg\n"; break;
+      case 30: text += L"wrongword\n"; break;
+      case 60: text += L"badword\n"; break;
+      case 80: text += L"adadsd\n"; break;
+      default: text += L"This is test document\n"; break;
+      }
+    }
+    editor.set_active_document_text(text);
+    editor.set_visible_lines(40, 49);
+    int scheduled_count = 0;
+    sc.prefetch_scheduled.connect([&] { ++scheduled_count; });
+    sc.recheck_visible();
+    CHECK(scheduled_count == 0);
+    CHECK(editor.get_underlined_words(indicator_id).empty());
+    CHECK_FALSE(sc.prefetch_next_chunk());
+
+    settings.modify()->data.prefetch_screen_count = 2;
+    CHECK(scheduled_count == 1);
+    int chunk_count = 1;
+    while (sc.prefetch_next_chunk())
+      ++chunk_count;
+    CHECK(chunk_count == 4);
+    CHECK(editor.get_underlined_words(indicator_id) == std::vector{"wrongword"s, "badword"s});
+
+    sc.recheck_visible();
+    sc.cancel_prefetch();
+    CHECK_FALSE(sc.prefetch_next_chunk());
+  }
+  SECTION("Misspelling report") {
+    editor.set_active_document_text(L"wrongword This is badword Badword\nbadword test WrongWord BADWORD");
+    auto report = sc.get_misspelling_report();
+    auto by_word = report.entries_by_word();
+    REQUIRE(by_word.size() == 2);
+    CHECK(by_word[0].word == L"badword");
+    CHECK(by_word[0].count == 4);
+    CHECK(by_word[0].first_position == 18);
+    CHECK(by_word[1].word == L"wrongword");
+    CHECK(by_word[1].count == 2);
+    CHECK(by_word[1].first_position == 0);
+    auto by_count = report.entries_by_count();
+    REQUIRE(by_count.size() == 2);
+    CHECK(by_count[0].word == L"badword");
+    CHECK(by_count[1].word == L"wrongword");
+    CHECK(sc.get_all_misspellings_as_string() == L"badword\nwrongword\n");
+  }
+  SECTION("Misspellings of large document") {
+    // document spans several check chunks and has no misspelling index
+    std::wstring text;
+    for (int i = 0; i < 5000; ++i) {
+      if (i == 10 || i == 4990)
+        text += L"abirvalg ";
+      if (i == 2000)
+        text += L"adadsd ";
+      text += L"This is test document\n";
+    }
+    editor.set_active_document_text(text);
+    REQUIRE_FALSE(sc.is_misspelling_index_complete());
+    sc.mark_lines_with_misspelling();
+    CHECK(editor.get_bookmarked_lines() == std::set<size_t>{10, 2000, 4990});
+    auto by_word = sc.get_misspelling_report().entries_by_word();
+    REQUIRE(by_word.size() == 2);
+    CHECK(by_word[0].word == L"abirvalg");
+    CHECK(by_word[0].count == 2);
+    CHECK(by_word[1].word == L"adadsd");
+    CHECK(by_word[1].count == 1);
+  }
+  SECTION("UTF-8 words") {
+    settings.modify()->data.remove_boundary_apostrophes = true;
+    editor.set_active_document_text(L"'немного' слов немонго\nИ ещё ошибкка. This is tеst");
+    auto entries = [&] {
+      auto by_word = sc.get_misspelling_report().entries_by_word();
+      std::vector<std::pair<std::wstring, TextPosition>> result;
+      for (auto &entry : by_word)
+        result.emplace_back(entry.word, entry.first_position);
+      return result;
+    };
+    auto wide_entries = entries();
+    CHECK(speller_ptr->checked_utf8_word_count() == 0);
+    speller_ptr->set_accepts_utf8_words(true);
+    settings.modify()->data.split_camel_case = false; // drops verdict cache
+    auto utf8_entries = entries();
+    CHECK(speller_ptr->checked_utf8_word_count() > 0);
+    CHECK(utf8_entries == wide_entries);
+    CHECK(utf8_entries == std::vector<std::pair<std::wstring, TextPosition>>{{L"tеst", 75}, {L"немонго", 26}, {L"ошибкка", 51}});
+    while (sc.update_misspelling_index()) {
+    }
+    REQUIRE(sc.is_misspelling_index_complete());
+    CHECK(entries() == wide_entries);
+    sc.mark_lines_with_misspelling();
+    CHECK(editor.get_bookmarked_lines() == std::set<size_t>{0, 1});
+  }
+  SECTION("UTF-8 words of large document") {
+    // styles and URLs are taken into account in all check chunks, not only the first one
+    speller_ptr->set_accepts_utf8_words(true);
+    std::wstring text;
+    for (int i = 0; i < 3000; ++i)
+      text += i == 2000 ? L"abirvalg adadsd\n" : L"This is test document\n";
+    editor.set_active_document_text(text);
+    const auto url_start = static_cast<TextPosition>(text.find(L"adadsd"));
+    editor.set_current_indicator(URL_INDIC);
+    editor.indicator_fill_range(url_start, url_start + 6);
+    CHECK(sc.get_all_misspellings_as_string() == L"abirvalg\n");
+    sc.mark_lines_with_misspelling();
+    CHECK(editor.get_bookmarked_lines() == std::set<size_t>{2000});
+    while (sc.update_misspelling_index()) {
+    }
+    REQUIRE(sc.is_misspelling_index_complete());
+    CHECK(sc.get_all_misspellings_as_string() == L"abirvalg\n");
+
+    editor.clear_bookmarks();
+    editor.set_lexer(SCLEX_CPP);
+    editor.set_whole_text_style(SCE_C_COMMENT);
+    settings.modify()->data.check_comments = false;
+    CHECK(sc.get_all_misspellings_as_string().empty());
+    sc.mark_lines_with_misspelling();
+    CHECK(editor.get_bookmarked_lines().empty());
+  }
+  SECTION("Misspelling index") {
+    std::wstring text;
+    for (int i = 0; i < 3000; ++i) {
+      if (i == 1000)
+        text += L"adadsd\n";
+      if (i == 2500)
+        text += L"abirvalg abirvalg\n";
+      text += L"This is test document\n";
+    }
+    editor.set_active_document_text(text);
+    CHECK_FALSE(sc.is_misspelling_index_complete());
+    while (sc.update_misspelling_index()) {
+    }
+    CHECK(sc.is_misspelling_index_complete());
+    sc.find_next_mistake();
+    CHECK(editor.selected_text() == "adadsd");
+    sc.find_next_mistake();
+    CHECK(editor.selected_text() == "abirvalg");
+    sc.find_next_mistake();
+    CHECK(editor.selected_text() == "abirvalg");
+    sc.find_next_mistake();
+    CHECK(editor.selected_text() == "adadsd");
+    sc.find_prev_mistake();
+    CHECK(editor.selected_text() == "abirvalg");
+    CHECK(sc.get_all_misspellings_as_string() == L"abirvalg\nadadsd\n");
+    sc.mark_lines_with_misspelling();
+    CHECK(editor.get_bookmarked_lines() == std::set<size_t>{1000, 2501});
+
+    editor.set_cursor_pos(0);
+    editor.replace_text(0, 0, "wrongword ");
+    sc.on_text_inserted(0, 10);
+    CHECK_FALSE(sc.is_misspelling_index_complete());
+    while (sc.update_misspelling_index()) {
+    }
+    sc.find_next_mistake();
+    CHECK(editor.selected_text() == "wrongword");
+    sc.find_next_mistake();
+    CHECK(editor.selected_text() == "adadsd");
+
+    // changing settings drops the index
+    settings.modify()->data.ignore_regexp_str = L"adadsd";
+    CHECK_FALSE(sc.is_misspelling_index_complete());
+  }
+  SECTION("Closed document") {
+    std::wstring text;
+    for (int i = 0; i < 3000; ++i)
+      text += i == 2000 ? L"adadsd\n" : L"This is test document\n";
+    editor.set_active_document_text(text);
+    while (sc.update_misspelling_index()) {
+    }
+    REQUIRE(sc.is_misspelling_index_complete());
+    sc.on_document_closed(L"test.txt");
+    editor.close_active_document();
+    // reopened after being changed outside, index of the old contents is not used
+    editor.open_virtual_document(L"test.txt", L"This is wrongword");
+    CHECK_FALSE(sc.is_misspelling_index_complete());
+    sc.find_next_mistake();
+    CHECK(editor.selected_text() == "wrongword");
+    CHECK(sc.get_all_misspellings_as_string() == L"wrongword\n");
+
+    editor.open_virtual_document(L"new 1", L"badword test");
+    while (sc.update_misspelling_index()) {
+    }
+    REQUIRE(sc.is_misspelling_index_complete());
+    sc.on_document_closed(L"new 1");
+    editor.close_active_document();
+    // next new document gets the same name
+    editor.open_virtual_document(L"new 1", L"");
+    CHECK(sc.get_misspelling_report().entries_by_word().empty());
+    editor.set_active_document_text(L"test");
+    CHECK(sc.get_all_misspellings_as_string().empty());
+  }
+  SECTION("Modifications in other windows") {
+    auto build_index = [&] {
+      ACTIVE_VIEW_BLOCK(editor);
+      while (sc.update_misspelling_index()) {
+      }
+    };
+    HWND second_view_hwnd;
+    {
+      TARGET_VIEW_BLOCK(editor, 1);
+      second_view_hwnd = editor.get_view_hwnd();
+      editor.open_virtual_document(L"other.txt", L"wrongword test");
+      build_index();
+      // same document cloned to second view
+      editor.open_virtual_document(L"test.txt", L"");
+    }
+    editor.activate_document(L"test.txt");
+    build_index();
+    REQUIRE(sc.is_misspelling_index_complete());
+
+    // already recorded through notification of active view
+    sc.on_other_window_modified(second_view_hwnd);
+    CHECK(sc.is_misspelling_index_complete());
+
+    // document not shown in any view
+    sc.on_other_window_modified(reinterpret_cast<HWND>(static_cast<intptr_t>(100)));
+    CHECK(sc.is_misspelling_index_complete());
+    {
+      TARGET_VIEW_BLOCK(editor, 1);
+      editor.activate_document(L"other.txt");
+    }
+    CHECK_FALSE(sc.is_misspelling_index_complete());
+    build_index();
+
+    // document shown in other view
+    editor.activate_document(L"test.txt");
+    sc.on_other_window_modified(second_view_hwnd);
+    CHECK(sc.is_misspelling_index_complete());
+    {
+      TARGET_VIEW_BLOCK(editor, 1);
+      editor.activate_document(L"other.txt");
+    }
+    CHECK_FALSE(sc.is_misspelling_index_complete());
+  }
+  SECTION("Async check of modified document") {
+    std::vector<std::pair<std::function<std::vector<bool>()>, std::function<void(std::vector<bool>)>>> posted;
+    sc.enable_async_checking([&](auto query, auto apply) { posted.emplace_back(std::move(query), std::move(apply)); });
+    auto run_posted = [&] {
+      auto [query, apply] = std::move(posted.front());
+      posted.erase(posted.begin());
+      apply(query());
+    };
+    editor.set_active_document_text(L"wrongword test");
+    editor.make_all_visible();
+    sc.recheck_visible();
+    REQUIRE(posted.size() == 1);
+    CHECK(editor.get_underlined_words(indicator_id).empty());
+
+    editor.replace_text(0, 9, "test badword");
+    sc.on_text_deleted(0, 9);
+    sc.on_text_inserted(0, 12);
+    // results for old text are dropped, visible text is checked again
+    run_posted();
+    CHECK(editor.get_underlined_words(indicator_id).empty());
+    REQUIRE(posted.size() == 1);
+    run_posted();
+    CHECK(editor.get_underlined_words(indicator_id) == std::vector{"badword"s});
+
+    editor.set_active_document_text(L"test badword abirvalg");
+    sc.recheck_visible();
+    REQUIRE(posted.size() == 1);
+    HWND second_view_hwnd;
+    {
+      TARGET_VIEW_BLOCK(editor, 1);
+      second_view_hwnd = editor.get_view_hwnd();
+      editor.open_virtual_document(L"test.txt", L"test badword abirvalg");
+    }
+    editor.activate_document(L"test.txt");
+    // modification of the same document reported by cloned view doesn't make results stale
+    sc.on_other_window_modified(second_view_hwnd);
+    run_posted();
+    CHECK(posted.empty());
+    CHECK(editor.get_underlined_words(indicator_id) == std::vector{"badword"s, "abirvalg"s});
+  }
+  SECTION("Async misspelling index") {
+    std::vector<std::pair<std::function<std::vector<bool>()>, std::function<void(std::vector<bool>)>>> posted;
+    sc.enable_async_checking([&](auto query, auto apply) { posted.emplace_back(std::move(query), std::move(apply)); });
+    auto run_posted = [&] {
+      auto [query, apply] = std::move(posted.front());
+      posted.erase(posted.begin());
+      apply(query());
+    };
+    int outdated_count = 0;
+    sc.misspelling_index_outdated.connect([&] { ++outdated_count; });
+    std::wstring text;
+    for (int i = 0; i < 3000; ++i)
+      text += i % 1000 == 500 ? L"abirvalg test\n" : L"This is test document\n";
+    editor.set_active_document_text(text);
+    // nothing to do until speller results for the chunk are applied
+    CHECK_FALSE(sc.update_misspelling_index());
+    REQUIRE(posted.size() == 1);
+    CHECK_FALSE(sc.update_misspelling_index());
+    CHECK(posted.size() == 1);
+
+    // results for modified document are dropped
+    editor.replace_text(11000, 11008, "badword");
+    sc.on_text_deleted(11000, 8);
+    sc.on_text_inserted(11000, 7);
+    outdated_count = 0;
+    run_posted();
+    CHECK(outdated_count == 1);
+    CHECK_FALSE(sc.is_misspelling_index_complete());
+
+    while (true) {
+      while (sc.update_misspelling_index()) {
+      }
+      if (posted.empty())
+        break;
+      run_posted();
+    }
+    REQUIRE(sc.is_misspelling_index_complete());
+    sc.mark_lines_with_misspelling();
+    CHECK(editor.get_bookmarked_lines() == std::set<size_t>{500, 1500, 2500});
+    CHECK(sc.get_all_misspellings_as_string() == L"abirvalg\nbadword\n");
+  }
   SECTION("Replace current word with topmost suggestion") {
     {
       editor.set_active_document_text(L"abcdef test");
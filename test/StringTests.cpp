@@ -12,10 +12,13 @@
 // along with this program; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
+#include "common/CharClassTable.h"
 #include "common/string_utils.h"
 #include "network/UrlHelpers.h"
 
 #include <catch.hpp>
+#include <random>
+#include <ranges>
 #include <string>
 
 using namespace std::literals;
@@ -110,6 +113,91 @@ TEST_CASE("CamelCase") {
   test_3();
 }
 
+TEST_CASE("Delimiter set") {
+  const std::wstring delimiters = L" \n\r\t,.;:!?()[]{}<>\"/\\|«»—…\u00a0";
+  DelimiterSet set(delimiters);
+  auto is_delimiter = [&](wchar_t c) { return delimiters.find(c) != std::wstring::npos; };
+  const std::wstring alphabet = delimiters + L"abcXYZ019_'тестSLOВО\u0100\u01ff\u2028\uffff\x7f\x80";
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<size_t> dist(0, alphabet.size() - 1);
+  std::wstring text(100 * DelimiterSet::block_size + 7, L' ');
+  for (auto &c : text)
+    c = alphabet[dist(gen)];
+
+  for (size_t i = 0; i + DelimiterSet::block_size <= text.size(); i += DelimiterSet::block_size) {
+    uint32_t expected = 0;
+    for (size_t j = 0; j < DelimiterSet::block_size; ++j)
+      expected |= static_cast<uint32_t>(is_delimiter(text[i + j])) << j;
+    CHECK(set.classify_block(text.data() + i) == expected);
+    CHECK(set.classify_block_scalar(text.data() + i) == expected);
+  }
+
+  for (auto split_camel_case : {false, true}) {
+    for (size_t length : {size_t{0}, size_t{1}, size_t{31}, size_t{32}, size_t{33}, size_t{64}, text.size()}) {
+      std::wstring_view target(text.data(), length);
+      CHECK(Tokenizer(target, set, split_camel_case).get_all_tokens() == Tokenizer(target, is_delimiter, split_camel_case).get_all_tokens());
+    }
+  }
+  std::wstring s = L"   TestCamelCase,and  more" + std::wstring(40, L' ') + L"WordsCrossingBlockBorder";
+  CHECK(make_delimiter_tokenizer(s, L" ,", true).get_all_tokens() ==
+        std::vector<std::wstring_view>{L"Test", L"Camel", L"Case", L"and", L"more", L"Words", L"Crossing", L"Block", L"Border"});
+}
+
+TEST_CASE("Lazy tokens") {
+  std::wstring s = L"first SecondThird   fourth";
+  auto tokenizer = make_delimiter_tokenizer(s, L" ", true);
+  std::vector<std::wstring_view> tokens;
+  for (auto token : tokenizer.tokens() | std::views::take(3))
+    tokens.push_back(token);
+  CHECK(tokens == std::vector<std::wstring_view>{L"first", L"Second", L"Third"});
+  CHECK(std::ranges::distance(tokenizer.tokens()) == 4);
+  CHECK(make_delimiter_tokenizer(L"   ", L" ").tokens().empty());
+}
+
+TEST_CASE("UTF-8 tokenizer") {
+  const std::wstring alphabet = L"abAB ,.'ёЁжЖ\x2014\xFFFD";
+  const DelimiterSet delimiters(L" ,.\x2014");
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<size_t> dist(0, alphabet.size() - 1);
+  for (int iteration = 0; iteration < 100; ++iteration) {
+    std::wstring text;
+    for (int i = 0; i < 50; ++i)
+      text.push_back(alphabet[dist(gen)]);
+    const auto utf8_text = utf8_encode(text);
+    CHECK(utf8_decode_bmp(utf8_text) == text);
+    for (bool split_camel_case : {false, true}) {
+      auto expected = Tokenizer(text, std::cref(delimiters), split_camel_case).get_all_tokens();
+      auto tokens = Utf8Tokenizer(utf8_text, delimiters, split_camel_case).get_all_tokens();
+      REQUIRE(tokens.size() == expected.size());
+      for (size_t i = 0; i < tokens.size(); ++i)
+        CHECK(utf8_decode_bmp(tokens[i]) == expected[i]);
+    }
+  }
+}
+
+TEST_CASE("Char class table") {
+  CharClassTable table;
+  table.set_non_alphabetic_delimiters(L"'_");
+  for (int i = 0; i <= 0xFFFF; ++i) {
+    const auto c = static_cast<wchar_t>(i);
+    const bool is_delimiter = !IsCharAlphaNumeric(c) && c != L'\'' && c != L'_';
+    if (table(c) != is_delimiter || table.is_upper(c) != (IsCharUpper(c) != FALSE) || table.is_lower(c) != (IsCharLower(c) != FALSE)) {
+      FAIL_CHECK("Class mismatch for character " << i);
+      break;
+    }
+  }
+  CHECK(table.is_digit(L'7'));
+  CHECK_FALSE(table.is_digit(L'z'));
+
+  std::wstring s = L"Don't_split тестовыеСлова, WordsAnd123; " + std::wstring(40, L'.') + L"end";
+  CHECK(Tokenizer(s, std::cref(table), true).get_all_tokens() ==
+        std::vector<std::wstring_view>{L"Don't_split", L"тестовые", L"Слова", L"Words", L"And123", L"end"});
+  table.set_delimiters(DelimiterSet(L" "));
+  CHECK(Tokenizer(s, std::cref(table), false).get_all_tokens() ==
+        std::vector<std::wstring_view>{L"Don't_split", L"тестовыеСлова,", L"WordsAnd123;", std::wstring_view(s).substr(40)});
+}
+
 TEST_CASE("to_upper_inplace") {
   auto word = L"ElEpHanT"s;
   to_upper_inplace(word);